@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/benchmark_pop_search"
+  "../bin/benchmark_pop_search.pdb"
+  "CMakeFiles/benchmark_pop_search.dir/pop_search.cpp.o"
+  "CMakeFiles/benchmark_pop_search.dir/pop_search.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_pop_search.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/benchmark_serde"
+  "../bin/benchmark_serde.pdb"
+  "CMakeFiles/benchmark_serde.dir/serde.cpp.o"
+  "CMakeFiles/benchmark_serde.dir/serde.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_serde.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
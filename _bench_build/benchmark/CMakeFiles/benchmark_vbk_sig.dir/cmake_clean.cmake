@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/benchmark_vbk_sig"
+  "../bin/benchmark_vbk_sig.pdb"
+  "CMakeFiles/benchmark_vbk_sig.dir/vbk_sig.cpp.o"
+  "CMakeFiles/benchmark_vbk_sig.dir/vbk_sig.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmark_vbk_sig.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+#----------------------------------------------------------------
+# Generated CMake target import file.
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "veriblock::veriblock-pop-cpp" for configuration ""
+set_property(TARGET veriblock::veriblock-pop-cpp APPEND PROPERTY IMPORTED_CONFIGURATIONS NOCONFIG)
+set_target_properties(veriblock::veriblock-pop-cpp PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_NOCONFIG "CXX"
+  IMPORTED_LOCATION_NOCONFIG "${_IMPORT_PREFIX}/lib/libveriblock-pop-cpp.a"
+  )
+
+list(APPEND _cmake_import_check_targets veriblock::veriblock-pop-cpp )
+list(APPEND _cmake_import_check_files_for_veriblock::veriblock-pop-cpp "${_IMPORT_PREFIX}/lib/libveriblock-pop-cpp.a" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
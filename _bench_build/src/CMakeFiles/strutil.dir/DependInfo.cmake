@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/base58.cpp" "src/CMakeFiles/strutil.dir/base58.cpp.o" "gcc" "src/CMakeFiles/strutil.dir/base58.cpp.o.d"
+  "/root/repo/src/base59.cpp" "src/CMakeFiles/strutil.dir/base59.cpp.o" "gcc" "src/CMakeFiles/strutil.dir/base59.cpp.o.d"
+  "/root/repo/src/strutil.cpp" "src/CMakeFiles/strutil.dir/strutil.cpp.o" "gcc" "src/CMakeFiles/strutil.dir/strutil.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
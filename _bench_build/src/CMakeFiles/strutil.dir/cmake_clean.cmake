@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/strutil.dir/base58.cpp.o"
+  "CMakeFiles/strutil.dir/base58.cpp.o.d"
+  "CMakeFiles/strutil.dir/base59.cpp.o"
+  "CMakeFiles/strutil.dir/base59.cpp.o.d"
+  "CMakeFiles/strutil.dir/strutil.cpp.o"
+  "CMakeFiles/strutil.dir/strutil.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/strutil.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vblake.dir/vblake.cpp.o"
+  "CMakeFiles/vblake.dir/vblake.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vblake.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
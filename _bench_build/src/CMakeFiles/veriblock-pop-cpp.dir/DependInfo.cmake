@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/arith_uint256.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/arith_uint256.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/arith_uint256.cpp.o.d"
+  "/root/repo/src/bytesearch.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/bytesearch.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/bytesearch.cpp.o.d"
+  "/root/repo/src/checks.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/checks.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/checks.cpp.o.d"
+  "/root/repo/src/config.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/config.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/config.cpp.o.d"
+  "/root/repo/src/hashutil.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/hashutil.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/hashutil.cpp.o.d"
+  "/root/repo/src/keystone_util.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/keystone_util.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/keystone_util.cpp.o.d"
+  "/root/repo/src/logger.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/logger.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/logger.cpp.o.d"
+  "/root/repo/src/mempool.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/mempool.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/mempool.cpp.o.d"
+  "/root/repo/src/mock_miner.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/mock_miner.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/mock_miner.cpp.o.d"
+  "/root/repo/src/read_stream.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/read_stream.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/read_stream.cpp.o.d"
+  "/root/repo/src/serde.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/serde.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/serde.cpp.o.d"
+  "/root/repo/src/signutil.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/signutil.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/signutil.cpp.o.d"
+  "/root/repo/src/stateless_validation.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/stateless_validation.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/stateless_validation.cpp.o.d"
+  "/root/repo/src/stateless_validation_cache.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/stateless_validation_cache.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/stateless_validation_cache.cpp.o.d"
+  "/root/repo/src/thread_pool.cpp" "src/CMakeFiles/veriblock-pop-cpp.dir/thread_pool.cpp.o" "gcc" "src/CMakeFiles/veriblock-pop-cpp.dir/thread_pool.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
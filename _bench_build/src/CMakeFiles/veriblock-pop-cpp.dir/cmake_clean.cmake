@@ -0,0 +1,39 @@
+file(REMOVE_RECURSE
+  "../lib/libveriblock-pop-cpp.a"
+  "../lib/libveriblock-pop-cpp.pdb"
+  "CMakeFiles/veriblock-pop-cpp.dir/arith_uint256.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/arith_uint256.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/bytesearch.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/bytesearch.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/checks.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/checks.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/config.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/config.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/hashutil.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/hashutil.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/keystone_util.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/keystone_util.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/logger.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/logger.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/mempool.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/mempool.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/mock_miner.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/mock_miner.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/read_stream.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/read_stream.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/serde.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/serde.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/signutil.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/signutil.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/stateless_validation.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/stateless_validation.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/stateless_validation_cache.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/stateless_validation_cache.cpp.o.d"
+  "CMakeFiles/veriblock-pop-cpp.dir/thread_pool.cpp.o"
+  "CMakeFiles/veriblock-pop-cpp.dir/thread_pool.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/veriblock-pop-cpp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/blockchain/alt_block_addon.cpp" "src/blockchain/CMakeFiles/blockchain.dir/alt_block_addon.cpp.o" "gcc" "src/blockchain/CMakeFiles/blockchain.dir/alt_block_addon.cpp.o.d"
+  "/root/repo/src/blockchain/alt_block_tree.cpp" "src/blockchain/CMakeFiles/blockchain.dir/alt_block_tree.cpp.o" "gcc" "src/blockchain/CMakeFiles/blockchain.dir/alt_block_tree.cpp.o.d"
+  "/root/repo/src/blockchain/btc_block_addon.cpp" "src/blockchain/CMakeFiles/blockchain.dir/btc_block_addon.cpp.o" "gcc" "src/blockchain/CMakeFiles/blockchain.dir/btc_block_addon.cpp.o.d"
+  "/root/repo/src/blockchain/btc_blockchain_util.cpp" "src/blockchain/CMakeFiles/blockchain.dir/btc_blockchain_util.cpp.o" "gcc" "src/blockchain/CMakeFiles/blockchain.dir/btc_blockchain_util.cpp.o.d"
+  "/root/repo/src/blockchain/vbk_block_addon.cpp" "src/blockchain/CMakeFiles/blockchain.dir/vbk_block_addon.cpp.o" "gcc" "src/blockchain/CMakeFiles/blockchain.dir/vbk_block_addon.cpp.o.d"
+  "/root/repo/src/blockchain/vbk_blockchain_util.cpp" "src/blockchain/CMakeFiles/blockchain.dir/vbk_blockchain_util.cpp.o" "gcc" "src/blockchain/CMakeFiles/blockchain.dir/vbk_blockchain_util.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
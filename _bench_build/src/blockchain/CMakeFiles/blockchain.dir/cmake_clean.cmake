@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/blockchain.dir/alt_block_addon.cpp.o"
+  "CMakeFiles/blockchain.dir/alt_block_addon.cpp.o.d"
+  "CMakeFiles/blockchain.dir/alt_block_tree.cpp.o"
+  "CMakeFiles/blockchain.dir/alt_block_tree.cpp.o.d"
+  "CMakeFiles/blockchain.dir/btc_block_addon.cpp.o"
+  "CMakeFiles/blockchain.dir/btc_block_addon.cpp.o.d"
+  "CMakeFiles/blockchain.dir/btc_blockchain_util.cpp.o"
+  "CMakeFiles/blockchain.dir/btc_blockchain_util.cpp.o.d"
+  "CMakeFiles/blockchain.dir/vbk_block_addon.cpp.o"
+  "CMakeFiles/blockchain.dir/vbk_block_addon.cpp.o.d"
+  "CMakeFiles/blockchain.dir/vbk_blockchain_util.cpp.o"
+  "CMakeFiles/blockchain.dir/vbk_blockchain_util.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/blockchain.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
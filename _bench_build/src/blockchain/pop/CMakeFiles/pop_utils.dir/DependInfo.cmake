@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/blockchain/pop/pop_state.cpp" "src/blockchain/pop/CMakeFiles/pop_utils.dir/pop_state.cpp.o" "gcc" "src/blockchain/pop/CMakeFiles/pop_utils.dir/pop_state.cpp.o.d"
+  "/root/repo/src/blockchain/pop/vbk_block_tree.cpp" "src/blockchain/pop/CMakeFiles/pop_utils.dir/vbk_block_tree.cpp.o" "gcc" "src/blockchain/pop/CMakeFiles/pop_utils.dir/vbk_block_tree.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
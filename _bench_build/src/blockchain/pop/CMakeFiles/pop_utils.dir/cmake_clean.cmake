@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pop_utils.dir/pop_state.cpp.o"
+  "CMakeFiles/pop_utils.dir/pop_state.cpp.o.d"
+  "CMakeFiles/pop_utils.dir/vbk_block_tree.cpp.o"
+  "CMakeFiles/pop_utils.dir/vbk_block_tree.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pop_utils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
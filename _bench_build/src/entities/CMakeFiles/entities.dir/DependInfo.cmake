@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/entities/address.cpp" "src/entities/CMakeFiles/entities.dir/address.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/address.cpp.o.d"
+  "/root/repo/src/entities/altblock.cpp" "src/entities/CMakeFiles/entities.dir/altblock.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/altblock.cpp.o.d"
+  "/root/repo/src/entities/atv.cpp" "src/entities/CMakeFiles/entities.dir/atv.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/atv.cpp.o.d"
+  "/root/repo/src/entities/btcblock.cpp" "src/entities/CMakeFiles/entities.dir/btcblock.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/btcblock.cpp.o.d"
+  "/root/repo/src/entities/btctx.cpp" "src/entities/CMakeFiles/entities.dir/btctx.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/btctx.cpp.o.d"
+  "/root/repo/src/entities/coin.cpp" "src/entities/CMakeFiles/entities.dir/coin.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/coin.cpp.o.d"
+  "/root/repo/src/entities/endorsements.cpp" "src/entities/CMakeFiles/entities.dir/endorsements.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/endorsements.cpp.o.d"
+  "/root/repo/src/entities/merkle_path.cpp" "src/entities/CMakeFiles/entities.dir/merkle_path.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/merkle_path.cpp.o.d"
+  "/root/repo/src/entities/output.cpp" "src/entities/CMakeFiles/entities.dir/output.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/output.cpp.o.d"
+  "/root/repo/src/entities/popdata.cpp" "src/entities/CMakeFiles/entities.dir/popdata.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/popdata.cpp.o.d"
+  "/root/repo/src/entities/popdata_view.cpp" "src/entities/CMakeFiles/entities.dir/popdata_view.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/popdata_view.cpp.o.d"
+  "/root/repo/src/entities/publication_data.cpp" "src/entities/CMakeFiles/entities.dir/publication_data.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/publication_data.cpp.o.d"
+  "/root/repo/src/entities/vbk_merkle_path.cpp" "src/entities/CMakeFiles/entities.dir/vbk_merkle_path.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/vbk_merkle_path.cpp.o.d"
+  "/root/repo/src/entities/vbkblock.cpp" "src/entities/CMakeFiles/entities.dir/vbkblock.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/vbkblock.cpp.o.d"
+  "/root/repo/src/entities/vbkpoptx.cpp" "src/entities/CMakeFiles/entities.dir/vbkpoptx.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/vbkpoptx.cpp.o.d"
+  "/root/repo/src/entities/vbktx.cpp" "src/entities/CMakeFiles/entities.dir/vbktx.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/vbktx.cpp.o.d"
+  "/root/repo/src/entities/vtb.cpp" "src/entities/CMakeFiles/entities.dir/vtb.cpp.o" "gcc" "src/entities/CMakeFiles/entities.dir/vtb.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
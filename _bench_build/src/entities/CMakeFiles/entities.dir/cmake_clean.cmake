@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/entities.dir/address.cpp.o"
+  "CMakeFiles/entities.dir/address.cpp.o.d"
+  "CMakeFiles/entities.dir/altblock.cpp.o"
+  "CMakeFiles/entities.dir/altblock.cpp.o.d"
+  "CMakeFiles/entities.dir/atv.cpp.o"
+  "CMakeFiles/entities.dir/atv.cpp.o.d"
+  "CMakeFiles/entities.dir/btcblock.cpp.o"
+  "CMakeFiles/entities.dir/btcblock.cpp.o.d"
+  "CMakeFiles/entities.dir/btctx.cpp.o"
+  "CMakeFiles/entities.dir/btctx.cpp.o.d"
+  "CMakeFiles/entities.dir/coin.cpp.o"
+  "CMakeFiles/entities.dir/coin.cpp.o.d"
+  "CMakeFiles/entities.dir/endorsements.cpp.o"
+  "CMakeFiles/entities.dir/endorsements.cpp.o.d"
+  "CMakeFiles/entities.dir/merkle_path.cpp.o"
+  "CMakeFiles/entities.dir/merkle_path.cpp.o.d"
+  "CMakeFiles/entities.dir/output.cpp.o"
+  "CMakeFiles/entities.dir/output.cpp.o.d"
+  "CMakeFiles/entities.dir/popdata.cpp.o"
+  "CMakeFiles/entities.dir/popdata.cpp.o.d"
+  "CMakeFiles/entities.dir/popdata_view.cpp.o"
+  "CMakeFiles/entities.dir/popdata_view.cpp.o.d"
+  "CMakeFiles/entities.dir/publication_data.cpp.o"
+  "CMakeFiles/entities.dir/publication_data.cpp.o.d"
+  "CMakeFiles/entities.dir/vbk_merkle_path.cpp.o"
+  "CMakeFiles/entities.dir/vbk_merkle_path.cpp.o.d"
+  "CMakeFiles/entities.dir/vbkblock.cpp.o"
+  "CMakeFiles/entities.dir/vbkblock.cpp.o.d"
+  "CMakeFiles/entities.dir/vbkpoptx.cpp.o"
+  "CMakeFiles/entities.dir/vbkpoptx.cpp.o.d"
+  "CMakeFiles/entities.dir/vbktx.cpp.o"
+  "CMakeFiles/entities.dir/vbktx.cpp.o.d"
+  "CMakeFiles/entities.dir/vtb.cpp.o"
+  "CMakeFiles/entities.dir/vtb.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/entities.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/poprewards.dir/poprewards.cpp.o"
+  "CMakeFiles/poprewards.dir/poprewards.cpp.o.d"
+  "CMakeFiles/poprewards.dir/poprewards_calculator.cpp.o"
+  "CMakeFiles/poprewards.dir/poprewards_calculator.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/poprewards.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
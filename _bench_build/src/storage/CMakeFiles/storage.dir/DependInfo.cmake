@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/storage/payloads_storage.cpp" "src/storage/CMakeFiles/storage.dir/payloads_storage.cpp.o" "gcc" "src/storage/CMakeFiles/storage.dir/payloads_storage.cpp.o.d"
+  "/root/repo/src/storage/pop_storage.cpp" "src/storage/CMakeFiles/storage.dir/pop_storage.cpp.o" "gcc" "src/storage/CMakeFiles/storage.dir/pop_storage.cpp.o.d"
+  "/root/repo/src/storage/repository_inmem.cpp" "src/storage/CMakeFiles/storage.dir/repository_inmem.cpp.o" "gcc" "src/storage/CMakeFiles/storage.dir/repository_inmem.cpp.o.d"
+  "/root/repo/src/storage/util.cpp" "src/storage/CMakeFiles/storage.dir/util.cpp.o" "gcc" "src/storage/CMakeFiles/storage.dir/util.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/storage.dir/payloads_storage.cpp.o"
+  "CMakeFiles/storage.dir/payloads_storage.cpp.o.d"
+  "CMakeFiles/storage.dir/pop_storage.cpp.o"
+  "CMakeFiles/storage.dir/pop_storage.cpp.o.d"
+  "CMakeFiles/storage.dir/repository_inmem.cpp.o"
+  "CMakeFiles/storage.dir/repository_inmem.cpp.o.d"
+  "CMakeFiles/storage.dir/util.cpp.o"
+  "CMakeFiles/storage.dir/util.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/storage.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
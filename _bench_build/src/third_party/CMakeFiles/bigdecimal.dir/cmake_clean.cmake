@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bigdecimal.dir/BigDecimal.cpp.o"
+  "CMakeFiles/bigdecimal.dir/BigDecimal.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bigdecimal.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
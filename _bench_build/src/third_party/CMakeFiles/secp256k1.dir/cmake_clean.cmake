@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/secp256k1.dir/secp256k1/secp256k1.cpp.o"
+  "CMakeFiles/secp256k1.dir/secp256k1/secp256k1.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/secp256k1.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
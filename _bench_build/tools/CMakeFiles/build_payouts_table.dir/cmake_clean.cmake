@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/build_payouts_table"
+  "../bin/build_payouts_table.pdb"
+  "CMakeFiles/build_payouts_table.dir/build_payouts_table.cpp.o"
+  "CMakeFiles/build_payouts_table.dir/build_payouts_table.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/build_payouts_table.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
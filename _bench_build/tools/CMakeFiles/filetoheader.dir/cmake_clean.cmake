@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/filetoheader"
+  "../bin/filetoheader.pdb"
+  "CMakeFiles/filetoheader.dir/filetoheader.cpp.o"
+  "CMakeFiles/filetoheader.dir/filetoheader.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/filetoheader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
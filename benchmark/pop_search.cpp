@@ -0,0 +1,70 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <veriblock/bytesearch.hpp>
+#include <veriblock/stateless_validation.hpp>
+
+using namespace altintegration;
+
+static std::vector<uint8_t> randomBytes(size_t size, int alphabet) {
+  std::mt19937 rng(0);
+  std::vector<uint8_t> v(size);
+  for (auto& b : v) {
+    b = (uint8_t)(rng() % alphabet);
+  }
+  return v;
+}
+
+// 80 bytes of PoP publication data placed at the very end of a BTC tx
+static void FindContiguousPopData(benchmark::State& state) {
+  auto tx = randomBytes(state.range(0), 256);
+  auto pop = randomBytes(80, 256);
+  pop[0] ^= 0x55;
+  std::copy(pop.begin(), pop.end(), tx.end() - pop.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(containsBytes(tx, pop));
+  }
+  state.SetBytesProcessed(state.iterations() * tx.size());
+}
+BENCHMARK(FindContiguousPopData)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// adversarial input: tx and pattern consist of the same byte, but the
+// pattern does not match
+static void FindContiguousPopDataWorstCase(benchmark::State& state) {
+  std::vector<uint8_t> tx(state.range(0), 0x00);
+  std::vector<uint8_t> pop(80, 0x00);
+  pop.back() = 0x01;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(containsBytes(tx, pop));
+  }
+  state.SetBytesProcessed(state.iterations() * tx.size());
+}
+BENCHMARK(FindContiguousPopDataWorstCase)
+    ->Arg(1 << 10)
+    ->Arg(1 << 16)
+    ->Arg(1 << 20);
+
+// tx is full of magic bytes followed by descriptors, none of which matches
+static void ContainsSplitMagicFlood(benchmark::State& state) {
+  auto pop = randomBytes(80, 256);
+  std::vector<uint8_t> tx;
+  tx.reserve(state.range(0));
+  // 4 chunks with zero offsets and lengths, so every candidate is compared
+  const std::vector<uint8_t> candidate{
+      0x92, 0x7a, 0x59, 0x46, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+  while (tx.size() + candidate.size() <= (size_t)state.range(0)) {
+    tx.insert(tx.end(), candidate.begin(), candidate.end());
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(containsSplit(pop, tx));
+  }
+  state.SetBytesProcessed(state.iterations() * tx.size());
+}
+BENCHMARK(ContainsSplitMagicFlood)->Arg(1 << 10)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,131 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <benchmark/benchmark.h>
+
+#include <veriblock/blockchain/block_index.hpp>
+#include <veriblock/entities/popdata.hpp>
+#include <veriblock/mock_miner.hpp>
+
+using namespace altintegration;
+
+// PopData with `vtbs` VTBs, one ATV and VBK context of 10 blocks
+static PopData makePopData(size_t vtbs) {
+  MockMiner miner;
+  ValidationState state;
+  auto* tip = miner.mineVbkBlocks(10);
+  for (size_t i = 0; i < vtbs; ++i) {
+    miner.vbkmempool.push_back(miner.endorseVbkBlock(
+        tip->getHeader(), miner.btc().getBestChain().tip()->getHash(), state));
+  }
+  tip = miner.mineVbkBlocks(1);
+
+  PublicationData pub;
+  pub.identifier = 0;
+  pub.header = std::vector<uint8_t>(80, 1);
+  pub.contextInfo = {1, 2, 3, 4, 5};
+  pub.payoutInfo = std::vector<uint8_t>(20, 2);
+  auto tx = miner.createVbkTxEndorsingAltBlock(pub);
+
+  PopData pop;
+  pop.atvs = {miner.applyATV(tx, state)};
+  pop.vtbs = miner.vbkPayloads[tip->getHash()];
+  for (auto* b = miner.vbk().getBestChain().tip(); b != nullptr;
+       b = b->pprev) {
+    pop.context.push_back(b->getHeader());
+    if (pop.context.size() == 10) {
+      break;
+    }
+  }
+  return pop;
+}
+
+static void DeserializeVTB(benchmark::State& state) {
+  auto bytes = makePopData(1).vtbs.at(0).toVbkEncoding();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(VTB::fromVbkEncoding(bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(DeserializeVTB);
+
+static void SerializeVTB(benchmark::State& state) {
+  auto vtb = makePopData(1).vtbs.at(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vtb.toVbkEncoding());
+  }
+}
+BENCHMARK(SerializeVTB);
+
+// serialize into a reused caller-provided buffer, without allocations
+static void SerializeVTBToExternalBuffer(benchmark::State& state) {
+  auto vtb = makePopData(1).vtbs.at(0);
+  std::vector<uint8_t> buf(vtb.estimateSize());
+  WriteStream stream(buf.data(), buf.size());
+  for (auto _ : state) {
+    stream.reset();
+    vtb.toVbkEncoding(stream);
+    benchmark::DoNotOptimize(stream.slice().data());
+  }
+}
+BENCHMARK(SerializeVTBToExternalBuffer);
+
+static void DeserializeATV(benchmark::State& state) {
+  auto bytes = makePopData(0).atvs.at(0).toVbkEncoding();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ATV::fromVbkEncoding(bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(DeserializeATV);
+
+static void SerializeATV(benchmark::State& state) {
+  auto atv = makePopData(0).atvs.at(0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(atv.toVbkEncoding());
+  }
+}
+BENCHMARK(SerializeATV);
+
+static void DeserializePopData(benchmark::State& state) {
+  auto bytes = makePopData(state.range(0)).toVbkEncoding();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PopData::fromVbkEncoding(bytes));
+  }
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(DeserializePopData)->Arg(1)->Arg(10);
+
+static void SerializePopData(benchmark::State& state) {
+  auto pop = makePopData(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pop.toVbkEncoding());
+  }
+}
+BENCHMARK(SerializePopData)->Arg(1)->Arg(10);
+
+static void DeserializeVbkBlockIndex(benchmark::State& state) {
+  auto pop = makePopData(1);
+  BlockIndex<VbkBlock> index;
+  index.setHeight(pop.context.at(0).height);
+  index.setHeader(pop.context.at(0));
+  auto bytes = index.toRaw();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BlockIndex<VbkBlock>::fromRaw(bytes));
+  }
+}
+BENCHMARK(DeserializeVbkBlockIndex);
+
+static void DeserializeBtcBlockIndex(benchmark::State& state) {
+  MockMiner miner;
+  auto* tip = miner.mineBtcBlocks(1);
+  auto bytes = tip->toRaw();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BlockIndex<BtcBlock>::fromRaw(bytes));
+  }
+}
+BENCHMARK(DeserializeBtcBlockIndex);
+
+BENCHMARK_MAIN();
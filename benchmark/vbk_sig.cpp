@@ -31,5 +31,51 @@ static void VerifySecp256k1Sig(benchmark::State& state) {
 }
 // Register the function as a benchmark
 BENCHMARK(VerifySecp256k1Sig);
+
+static VbkTx makeSignedTx(int64_t signatureIndex) {
+  auto privateKey = privateKeyFromVbk(defaultPrivateKeyVbk);
+  VbkTx tx;
+  tx.networkOrType.typeId = (uint8_t)TxType::VBK_TX;
+  tx.sourceAddress = Address::fromPublicKey(defaultPublicKeyVbk);
+  tx.signatureIndex = signatureIndex;
+  tx.publicKey = defaultPublicKeyVbk;
+  auto hash = tx.getHash();
+  tx.signature = veriBlockSign(hash, privateKey);
+  return tx;
+}
+
+static void CheckSignatureSequential(benchmark::State& state) {
+  std::vector<VbkTx> txes;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    txes.push_back(makeSignedTx(i));
+  }
+
+  for (auto _ : state) {
+    for (const auto& tx : txes) {
+      ValidationState s;
+      checkSignature(tx, s);
+    }
+  }
+}
+BENCHMARK(CheckSignatureSequential)->Arg(64);
+
+static void CheckSignaturesBatch(benchmark::State& state) {
+  std::vector<VbkTx> txes;
+  std::vector<const VbkTx*> ptrs;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    txes.push_back(makeSignedTx(i));
+  }
+  for (const auto& tx : txes) {
+    ptrs.push_back(&tx);
+  }
+
+  ThreadPool pool;
+  std::vector<ValidationState> states;
+  for (auto _ : state) {
+    checkSignatures(ptrs, states, &pool);
+  }
+}
+BENCHMARK(CheckSignaturesBatch)->Arg(64);
+
 // Run the benchmark
 BENCHMARK_MAIN();
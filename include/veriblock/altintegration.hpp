@@ -6,11 +6,14 @@
 #ifndef ALTINTEGRATION_ALTINTEGRATION_HPP
 #define ALTINTEGRATION_ALTINTEGRATION_HPP
 
+#include <algorithm>
 #include <veriblock/alt-util.hpp>
 #include <veriblock/blockchain/alt_block_tree.hpp>
 #include <veriblock/config.hpp>
 #include <veriblock/mempool.hpp>
+#include <veriblock/stateless_validation.hpp>
 #include <veriblock/storage/payloads_storage.hpp>
+#include <veriblock/thread_pool.hpp>
 
 namespace altintegration {
 
@@ -30,6 +33,12 @@ struct Altintegration {
                                                  *service->store);
     service->mempool =
         std::make_shared<altintegration::MemPool>(*service->altTree);
+    if (service->config->statelessValidationThreads > 0) {
+      service->pool = std::make_shared<ThreadPool>(
+          service->config->statelessValidationThreads);
+      service->mempool->setThreadPool(service->pool);
+    }
+    service->mempool->setMaxSize(service->config->mempoolMaxSize);
 
     ValidationState state;
 
@@ -58,20 +67,42 @@ struct Altintegration {
   }
 
   bool checkPopData(const PopData& popData, ValidationState& state) {
+    std::vector<ValidationState> vtbStates;
+    std::vector<ValidationState> atvStates;
+    return checkPopData(popData, state, vtbStates, atvStates);
+  }
+
+  /**
+   * Statelessly check all payloads in `popData`.
+   *
+   * VTBs and ATVs are checked in batches (see checkVTBs, checkATVs), in
+   * parallel if Config::statelessValidationThreads is not 0.
+   * @param[in] popData payloads to check
+   * @param[out] state first failure, prefixed with the kind of payload
+   * @param[out] vtbStates validation state of every VTB, in the order of
+   * popData.vtbs; left untouched if context is invalid
+   * @param[out] atvStates validation state of every ATV, in the order of
+   * popData.atvs; left untouched if context or any VTB is invalid
+   * @return true if all payloads are valid
+   */
+  bool checkPopData(const PopData& popData,
+                    ValidationState& state,
+                    std::vector<ValidationState>& vtbStates,
+                    std::vector<ValidationState>& atvStates) {
+    // stop at the first invalid group: bogus context or VTBs must not force
+    // verification of the remaining payloads
     if (!checkVbkBlocks(popData.context, state, *config->vbk.params)) {
       return state.Invalid("pop-vbkblock-statelessly-invalid");
     }
 
-    for (const auto& vtb : popData.vtbs) {
-      if (!checkVTB(vtb, state, *config->btc.params)) {
-        return state.Invalid("pop-vtb-statelessly-invalid");
-      }
+    if (!checkVTBs(popData.vtbs, vtbStates, *config->btc.params, pool.get())) {
+      state = firstInvalid(vtbStates);
+      return state.Invalid("pop-vtb-statelessly-invalid");
     }
 
-    for (const auto& atv : popData.atvs) {
-      if (!checkATV(atv, state, *config->alt)) {
-        return state.Invalid("pop-atv-statelessly-invalid");
-      }
+    if (!checkATVs(popData.atvs, atvStates, *config->alt, pool.get())) {
+      state = firstInvalid(atvStates);
+      return state.Invalid("pop-atv-statelessly-invalid");
     }
 
     return true;
@@ -83,6 +114,19 @@ struct Altintegration {
   std::shared_ptr<AltTree> altTree;
   std::shared_ptr<PayloadsStorage> store;
   std::vector<PopData> disconnected_popdata;
+  //! workers for stateless validation, nullptr if disabled
+  std::shared_ptr<ThreadPool> pool;
+
+ private:
+  static const ValidationState& firstInvalid(
+      const std::vector<ValidationState>& states) {
+    auto it = std::find_if(
+        states.begin(), states.end(), [](const ValidationState& s) {
+          return !s.IsValid();
+        });
+    VBK_ASSERT(it != states.end());
+    return *it;
+  }
 };
 
 }  // namespace altintegration
@@ -74,6 +74,15 @@ struct AltBlockAddon : public PopState<AltEndorsement> {
     writeArrayOf<uint96>(w, _vbkblockids, writeSingleByteLenValue);
   }
 
+  //! compact encoding: endorsements are stored as positions in `_atvids`
+  template <typename Hash>
+  void toRawCompact(WriteStream& w, const Hash& hash) const {
+    writeCompactArrayOf(w, _atvids);
+    writeCompactArrayOf(w, _vtbids);
+    writeCompactArrayOf(w, _vbkblockids);
+    PopState<AltEndorsement>::toRawCompact(w, _atvids, hash);
+  }
+
  protected:
   //! list of changes introduced in this block
   // ATV::id_t
@@ -101,6 +110,14 @@ struct AltBlockAddon : public PopState<AltEndorsement> {
         r, [](ReadStream& s) -> uint96 { return readSingleByteLenValue(s); });
   }
 
+  template <typename Hash>
+  void initAddonFromRawCompact(ReadStream& r, const Hash& hash) {
+    _atvids = readCompactArrayOf<SHA256_HASH_SIZE>(r);
+    _vtbids = readCompactArrayOf<SHA256_HASH_SIZE>(r);
+    _vbkblockids = readCompactArrayOf<VBLAKE_PREVIOUS_BLOCK_HASH_SIZE>(r);
+    PopState<AltEndorsement>::initAddonFromRawCompact(r, _atvids, hash);
+  }
+
   template <typename pop_t>
   std::vector<typename pop_t::id_t>& getPayloadIdsInner();
 };
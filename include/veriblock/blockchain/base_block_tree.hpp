@@ -110,7 +110,11 @@ struct BaseBlockTree {
     }
 
     current->setFlag(BLOCK_VALID_TREE);
-    current->unsetDirty();
+    // blocks decoded from the legacy encoding stay dirty, so that the next
+    // save rewrites them in the compact encoding
+    if (!index.isDirty()) {
+      current->unsetDirty();
+    }
 
     tryAddTip(current);
 
@@ -14,6 +14,7 @@
 #include <veriblock/blockchain/command_group.hpp>
 #include <veriblock/entities/endorsements.hpp>
 #include <veriblock/logger.hpp>
+#include <veriblock/serde.hpp>
 #include <veriblock/validation_state.hpp>
 #include <veriblock/write_stream.hpp>
 
@@ -210,14 +211,65 @@ struct BlockIndex : public Block::addon_t {
     return fmt::sprintf("%s:%d:%s", Block::name(), height, HexStr(getHash()));
   }
 
+  //! first byte of the compact encoding. Legacy encoding starts with
+  //! big-endian height, whose most significant byte is never 0xff.
+  static constexpr uint8_t COMPACT_ENCODING_MARKER = 0xff;
+  //! version of the compact encoding
+  static constexpr uint8_t COMPACT_ENCODING_VERSION = 1;
+  //! offset of the header in the compact encoding
+  static constexpr size_t COMPACT_ENCODING_HEADER_OFFSET = 2;
+
+  /**
+   * Write block in the versioned compact encoding:
+   * `[0xff | version | header | varint height | varint status | addon]`.
+   *
+   * Header is written at a fixed offset, and BTC and VBK headers have fixed
+   * size, so a reader may pick up the header without parsing anything else.
+   * Addon stores endorsements as references to payload ids of this block.
+   */
   void toRaw(WriteStream& stream) const {
+    stream.writeBE<uint8_t>(COMPACT_ENCODING_MARKER);
+    stream.writeBE<uint8_t>(COMPACT_ENCODING_VERSION);
+    header->toRaw(stream);
+    writeVarInt(stream, (uint32_t)height);
+    writeVarInt(stream, status);
+    addon_t::toRawCompact(stream, getHash());
+  }
+
+  /**
+   * Read block in either compact or legacy encoding. Block read from the
+   * legacy encoding is marked dirty, so that it is migrated to the compact
+   * encoding on the next save.
+   */
+  void initFromRaw(ReadStream& stream) {
+    const auto begin = stream.position();
+    if (stream.readBE<uint8_t>() != COMPACT_ENCODING_MARKER) {
+      stream.setPosition(begin);
+      initFromLegacyRaw(stream);
+      return;
+    }
+
+    const auto version = stream.readBE<uint8_t>();
+    if (version != COMPACT_ENCODING_VERSION) {
+      throw std::out_of_range(
+          fmt::sprintf("BlockIndex: unknown encoding version %d", version));
+    }
+    header = std::make_shared<Block>(Block::fromRaw(stream));
+    height = (height_t)(uint32_t)readVarInt(stream);
+    status = (uint32_t)readVarInt(stream);
+    addon_t::initAddonFromRawCompact(stream, getHash());
+    unsetDirty();
+  }
+
+  //! write block in the legacy (pre-compact) encoding
+  void toLegacyRaw(WriteStream& stream) const {
     stream.writeBE<uint32_t>(height);
     header->toRaw(stream);
     stream.writeBE<uint32_t>(status);
     addon_t::toRaw(stream);
   }
 
-  void initFromRaw(ReadStream& stream) {
+  void initFromLegacyRaw(ReadStream& stream) {
     height = stream.readBE<uint32_t>();
     header = std::make_shared<Block>(Block::fromRaw(stream));
     status = stream.readBE<uint32_t>();
@@ -256,6 +308,13 @@ struct BlockIndex : public Block::addon_t {
   bool dirty = false;
 };
 
+template <typename Block>
+constexpr uint8_t BlockIndex<Block>::COMPACT_ENCODING_MARKER;
+template <typename Block>
+constexpr uint8_t BlockIndex<Block>::COMPACT_ENCODING_VERSION;
+template <typename Block>
+constexpr size_t BlockIndex<Block>::COMPACT_ENCODING_HEADER_OFFSET;
+
 template <typename Block>
 void PrintTo(const BlockIndex<Block>& b, ::std::ostream* os) {
   *os << b.toPrettyString();
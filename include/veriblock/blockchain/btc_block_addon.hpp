@@ -64,6 +64,27 @@ struct BtcBlockAddon {
         r, [](ReadStream& stream) { return stream.readBE<ref_height_t>(); });
   }
 
+  //! compact encoding: varint count followed by varint refs
+  template <typename Hash>
+  void toRawCompact(WriteStream& w, const Hash&) const {
+    writeVarInt(w, refs.size());
+    for (const auto& ref : refs) {
+      writeVarInt(w, (uint32_t)ref);
+    }
+  }
+
+  template <typename Hash>
+  void initAddonFromRawCompact(ReadStream& r, const Hash&) {
+    const auto count = readVarInt(r);
+    if (count > r.remaining()) {
+      throw std::out_of_range("refs: out of data");
+    }
+    refs.resize((size_t)count);
+    for (auto& ref : refs) {
+      ref = (ref_height_t)(uint32_t)readVarInt(r);
+    }
+  }
+
   std::string toPrettyString() const {
     return fmt::format("chainwork={}", chainWork.toHex());
   }
@@ -6,6 +6,7 @@
 #ifndef VERIBLOCK_POP_CPP_POP_STATE_HPP
 #define VERIBLOCK_POP_CPP_POP_STATE_HPP
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -66,8 +67,60 @@ struct PopState {
         });
   }
 
+  /**
+   * Compact encoding of containing endorsements.
+   *
+   * Endorsement id equals id of the payload which produced it, so an
+   * endorsement is stored as a position in `payloadIds` of the owning block.
+   * Containing hash is omitted when it equals `containingHash` (hash of the
+   * owning block). Both are written explicitly otherwise.
+   */
+  template <typename Hash>
+  void toRawCompact(WriteStream& w,
+                    const std::vector<eid_t>& payloadIds,
+                    const Hash& containingHash) const {
+    writeVarInt(w, _containingEndorsements.size());
+    for (const auto& pair : _containingEndorsements) {
+      const auto& e = *pair.second;
+      auto it = std::find(payloadIds.begin(), payloadIds.end(), e.id);
+      uint8_t flags = 0;
+      if (it == payloadIds.end()) {
+        flags |= EXPLICIT_ID;
+      }
+      if (!sameBytes(e.containingHash, containingHash)) {
+        flags |= EXPLICIT_CONTAINING;
+      }
+
+      w.writeBE<uint8_t>(flags);
+      if (flags & EXPLICIT_ID) {
+        w.write(e.id);
+      } else {
+        writeVarInt(w, (uint64_t)std::distance(payloadIds.begin(), it));
+      }
+      if (flags & EXPLICIT_CONTAINING) {
+        writeSingleByteLenValue(w, e.containingHash);
+      }
+      writeSingleByteLenValue(w, e.endorsedHash);
+      writeSingleByteLenValue(w, e.blockOfProof);
+      writeSingleByteLenValue(w, e.payoutInfo);
+    }
+  }
+
   // hide setters from public usage
  protected:
+  //! flags of compact endorsement encoding
+  enum : uint8_t {
+    //! endorsement id is not among payload ids of the block
+    EXPLICIT_ID = 1 << 0,
+    //! containing hash is not the hash of the block
+    EXPLICIT_CONTAINING = 1 << 1,
+  };
+
+  template <typename A, typename B>
+  static bool sameBytes(const A& a, const B& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+  }
+
   //! (stored as vector) list of containing endorsements in this block
   containing_endorsement_store_t _containingEndorsements{};
 
@@ -91,6 +144,43 @@ struct PopState {
     // do not restore 'endorsedBy', it will be done later
   }
 
+  template <typename Hash>
+  void initAddonFromRawCompact(ReadStream& r,
+                               const std::vector<eid_t>& payloadIds,
+                               const Hash& containingHash) {
+    const auto count = readVarInt(r);
+    for (uint64_t i = 0; i < count; ++i) {
+      auto e = std::make_shared<endorsement_t>();
+      const auto flags = r.readBE<uint8_t>();
+      if ((flags & ~(EXPLICIT_ID | EXPLICIT_CONTAINING)) != 0) {
+        throw std::out_of_range("endorsement: unknown flags");
+      }
+
+      if (flags & EXPLICIT_ID) {
+        r.read(e->id);
+      } else {
+        const auto pos = readVarInt(r);
+        if (pos >= payloadIds.size()) {
+          throw std::out_of_range("endorsement: payload position is too big");
+        }
+        e->id = payloadIds[(size_t)pos];
+      }
+      if (flags & EXPLICIT_CONTAINING) {
+        e->containingHash = readSingleByteLenValue(r).asVector();
+      } else {
+        e->containingHash =
+            std::vector<uint8_t>(containingHash.begin(), containingHash.end());
+      }
+      e->endorsedHash = readSingleByteLenValue(r).asVector();
+      e->blockOfProof = readSingleByteLenValue(r).asVector();
+      e->payoutInfo = readSingleByteLenValue(r).asVector();
+
+      auto id = e->id;
+      _containingEndorsements.insert({id, std::move(e)});
+    }
+    // do not restore 'endorsedBy', it will be done later
+  }
+
   void initAddonFromOther(const PopState& other) {
     _containingEndorsements = other._containingEndorsements;
     endorsedBy = other.endorsedBy;
@@ -87,6 +87,14 @@ struct VbkBlockAddon : public PopState<VbkEndorsement> {
     writeArrayOf<uint256>(w, _vtbids, writeSingleByteLenValue);
   }
 
+  //! compact encoding: endorsements are stored as positions in `_vtbids`
+  template <typename Hash>
+  void toRawCompact(WriteStream& w, const Hash& hash) const {
+    writeVarInt(w, _refCount);
+    writeCompactArrayOf(w, _vtbids);
+    PopState<VbkEndorsement>::toRawCompact(w, _vtbids, hash);
+  }
+
  protected:
   //! reference counter for fork resolution
   uint32_t _refCount = 0;
@@ -109,6 +117,13 @@ struct VbkBlockAddon : public PopState<VbkEndorsement> {
     _vtbids = readArrayOf<uint256>(
         r, [](ReadStream& s) -> uint256 { return readSingleByteLenValue(s); });
   }
+
+  template <typename Hash>
+  void initAddonFromRawCompact(ReadStream& r, const Hash& hash) {
+    _refCount = (uint32_t)readVarInt(r);
+    _vtbids = readCompactArrayOf<SHA256_HASH_SIZE>(r);
+    PopState<VbkEndorsement>::initAddonFromRawCompact(r, _vtbids, hash);
+  }
 };
 
 }  // namespace altintegration
@@ -0,0 +1,40 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef VERIBLOCK_POP_CPP_BYTESEARCH_HPP
+#define VERIBLOCK_POP_CPP_BYTESEARCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "slice.hpp"
+
+namespace altintegration {
+
+/**
+ * Find first occurrence of `needle` in `haystack`.
+ *
+ * Uses memchr for single-byte needles and the Two-Way string matching
+ * algorithm otherwise, so it runs in O(n + m) time with constant memory
+ * regardless of input.
+ * @param haystack bytes to search in
+ * @param needle bytes to search for
+ * @param from position in `haystack` to start search from
+ * @return position of first occurrence at or after `from`, or
+ * haystack.size() if there is none. Empty needle is found at `from`.
+ */
+size_t findBytes(Slice<const uint8_t> haystack,
+                 Slice<const uint8_t> needle,
+                 size_t from = 0);
+
+//! @return true if `needle` is a contiguous part of `haystack`
+inline bool containsBytes(Slice<const uint8_t> haystack,
+                          Slice<const uint8_t> needle) {
+  return needle.size() == 0 || findBytes(haystack, needle) != haystack.size();
+}
+
+}  // namespace altintegration
+
+#endif  // VERIBLOCK_POP_CPP_BYTESEARCH_HPP
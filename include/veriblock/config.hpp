@@ -84,6 +84,15 @@ struct Config {
   Bootstrap<BtcBlock, BtcChainParams> btc;
   Bootstrap<VbkBlock, VbkChainParams> vbk;
 
+  //! number of worker threads used for stateless validation of payloads in
+  //! Altintegration::checkPopData and MemPool::submitAll. 0 means validate on
+  //! the calling thread.
+  uint32_t statelessValidationThreads = 0;
+
+  //! limit of serialized size of payloads stored in MemPool, in bytes. 0
+  //! means no limit. @see MemPool::setMaxSize
+  size_t mempoolMaxSize = 0;
+
   //! helper, which converts array of hexstrings (blocks) into "Bootstrap" type
   void setBTC(int32_t start,
               const std::vector<std::string>& hexblocks,
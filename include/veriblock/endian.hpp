@@ -0,0 +1,117 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef ALT_INTEGRATION_VERIBLOCK_ENDIAN_HPP
+#define ALT_INTEGRATION_VERIBLOCK_ENDIAN_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <cstdlib>
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define VBK_BIG_ENDIAN 1
+#else
+#define VBK_BIG_ENDIAN 0
+#endif
+
+namespace altintegration {
+
+//! @private
+namespace endian {
+
+inline uint8_t bswap(uint8_t v) { return v; }
+
+inline uint16_t bswap(uint16_t v) {
+#if defined(_MSC_VER)
+  return _byteswap_ushort(v);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap16(v);
+#else
+  return (uint16_t)((v >> 8) | (v << 8));
+#endif
+}
+
+inline uint32_t bswap(uint32_t v) {
+#if defined(_MSC_VER)
+  return _byteswap_ulong(v);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap32(v);
+#else
+  return ((v & 0xff000000u) >> 24) | ((v & 0x00ff0000u) >> 8) |
+         ((v & 0x0000ff00u) << 8) | ((v & 0x000000ffu) << 24);
+#endif
+}
+
+inline uint64_t bswap(uint64_t v) {
+#if defined(_MSC_VER)
+  return _byteswap_uint64(v);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(v);
+#else
+  return ((uint64_t)bswap((uint32_t)v) << 32) | bswap((uint32_t)(v >> 32));
+#endif
+}
+
+template <typename T>
+using unsigned_t = typename std::conditional<
+    sizeof(T) == 1,
+    uint8_t,
+    typename std::conditional<
+        sizeof(T) == 2,
+        uint16_t,
+        typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type>::
+        type>::type;
+
+//! load big-endian integer T from unaligned memory `p`
+template <typename T>
+T loadBE(const uint8_t* p) {
+  unsigned_t<T> u;
+  std::memcpy(&u, p, sizeof(u));
+#if !VBK_BIG_ENDIAN
+  u = bswap(u);
+#endif
+  return (T)u;
+}
+
+//! load little-endian integer T from unaligned memory `p`
+template <typename T>
+T loadLE(const uint8_t* p) {
+  unsigned_t<T> u;
+  std::memcpy(&u, p, sizeof(u));
+#if VBK_BIG_ENDIAN
+  u = bswap(u);
+#endif
+  return (T)u;
+}
+
+//! store integer `v` as big-endian to unaligned memory `p`
+template <typename T>
+void storeBE(uint8_t* p, T v) {
+  auto u = (unsigned_t<T>)v;
+#if !VBK_BIG_ENDIAN
+  u = bswap(u);
+#endif
+  std::memcpy(p, &u, sizeof(u));
+}
+
+//! store integer `v` as little-endian to unaligned memory `p`
+template <typename T>
+void storeLE(uint8_t* p, T v) {
+  auto u = (unsigned_t<T>)v;
+#if VBK_BIG_ENDIAN
+  u = bswap(u);
+#endif
+  std::memcpy(p, &u, sizeof(u));
+}
+
+}  // namespace endian
+
+}  // namespace altintegration
+
+#endif  // ALT_INTEGRATION_VERIBLOCK_ENDIAN_HPP
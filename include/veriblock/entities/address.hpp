@@ -89,12 +89,19 @@ struct Address {
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
  private:
-  Address(AddressType type, std::string addr)
-      : m_Type(type), m_Address(std::move(addr)) {}
+  Address(AddressType type, std::string addr);
 
   AddressType m_Type{};
   std::string m_Address{};
+  // size of decoded address, so that estimateSize does not decode it
+  size_t m_DecodedSize = 0;
 };
 
 template <typename Value>
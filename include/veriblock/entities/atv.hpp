@@ -28,7 +28,8 @@ struct ATV {
   VbkMerklePath merklePath{};
   VbkBlock blockOfProof{};
 
-  //! (memory only) indicates whether we already did 'checkATV' on this ATV
+  //! (memory only) indicates whether we already did 'checkATV' on this ATV.
+  //! Copies of this ATV are served by StatelessValidationCache instead.
   mutable bool checked{false};
 
   std::string toHex() const { return HexStr(toVbkEncoding()); }
@@ -59,6 +60,12 @@ struct ATV {
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   /**
    * Convert ATV to raw bytes data using Vbk byte format
    * @return bytes data
@@ -58,6 +58,12 @@ struct BtcBlock {
    */
   void toRaw(WriteStream& stream) const;
 
+  /**
+   * Calculate size of basic byte format without serializing
+   * @return size of toRaw output in bytes
+   */
+  size_t estimateRawSize() const;
+
   /**
    * Convert BtcBlock to bytes data using BtcBlock basic byte format
    * @return string represantation of the data
@@ -76,6 +82,12 @@ struct BtcBlock {
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   uint32_t getDifficulty() const;
 
   uint32_t getBlockTime() const;
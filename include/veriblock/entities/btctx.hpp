@@ -42,6 +42,12 @@ struct BtcTx {
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   /**
    * Calculate the hash of the btc transaction
    * @return hash transaction hash
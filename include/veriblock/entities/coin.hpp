@@ -35,6 +35,12 @@ struct Coin {
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   /**
    * Compare two Coins for equality
    * @param other Coin
@@ -42,12 +42,24 @@ struct MerklePath {
    */
   void toRaw(WriteStream& stream) const;
 
+  /**
+   * Calculate size of basic byte format without serializing
+   * @return size of toRaw output in bytes
+   */
+  size_t estimateRawSize() const;
+
   /**
    * Convert MerklePath to data stream using MerklePath VBK byte format
    * @param stream data stream to write into
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   /**
    * Calculate the hash of the merkle root
    * @return hash merkle root hash
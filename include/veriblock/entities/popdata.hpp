@@ -31,7 +31,11 @@ struct PopData {
     atvs.insert(atvs.end(), p.atvs.begin(), p.atvs.end());
   }
 
-  size_t estimateSize() const { return toVbkEncoding().size(); }
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
 
   /**
    * Read VBK data from the stream and convert it to PopData
@@ -0,0 +1,171 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef ALT_INTEGRATION_INCLUDE_VERIBLOCK_ENTITIES_POPDATA_VIEW_HPP_
+#define ALT_INTEGRATION_INCLUDE_VERIBLOCK_ENTITIES_POPDATA_VIEW_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "veriblock/entities/atv.hpp"
+#include "veriblock/entities/btcblock.hpp"
+#include "veriblock/entities/popdata.hpp"
+#include "veriblock/entities/vbk_merkle_path.hpp"
+#include "veriblock/entities/vbkblock.hpp"
+#include "veriblock/entities/vtb.hpp"
+#include "veriblock/read_stream.hpp"
+#include "veriblock/slice.hpp"
+#include "veriblock/uint.hpp"
+
+namespace altintegration {
+
+/**
+ * Non-owning views over VBK-encoded payloads.
+ *
+ * A view is created by walking the encoding once and remembering where every
+ * field starts: nested transactions are not decoded and no bytes are copied.
+ * Ids, headers and merkle roots are computed directly from the underlying
+ * buffer. Owning objects are materialized with toATV/toVTB/toPopData only
+ * when they have to be stored.
+ *
+ * fromVbkEncoding does the same bounds checks as fromVbkEncoding of owning
+ * payload, including checks of nested transaction, and additionally rejects
+ * trailing bytes in nested transaction. Semantic checks, which require
+ * decoding (e.g. address checksum), are done by toATV/toVTB.
+ *
+ * @warning a view is valid as long as the buffer it was created from is
+ * alive and not modified.
+ */
+
+//! View of VbkMerklePath
+struct VbkMerklePathView {
+  int32_t treeIndex = -1;
+  int32_t index = -1;
+  uint256 subject{};
+
+  //! number of layers
+  size_t size() const { return layersCount_; }
+
+  //! i-th layer, starting from the bottom
+  uint256 layer(size_t i) const;
+
+  //! @see VbkMerklePath::calculateMerkleRoot
+  uint128 calculateMerkleRoot() const;
+
+  VbkMerklePath toVbkMerklePath() const;
+
+  static VbkMerklePathView fromVbkEncoding(ReadStream& stream);
+
+ private:
+  // consecutive [1 byte size | 32 bytes hash] entries
+  Slice<const uint8_t> layers_;
+  size_t layersCount_ = 0;
+};
+
+//! View of ATV
+struct ATVView {
+  uint32_t version = 1;
+
+  //! whole VBK encoding of this ATV
+  Slice<const uint8_t> data() const { return data_; }
+
+  //! raw VbkTx, as hashed by VbkTx::getHash
+  Slice<const uint8_t> rawTransaction() const { return rawTx_; }
+  Slice<const uint8_t> signature() const { return signature_; }
+  Slice<const uint8_t> publicKey() const { return publicKey_; }
+  const VbkMerklePathView& merklePath() const { return merklePath_; }
+
+  VbkBlock blockOfProof() const;
+
+  uint256 getTransactionHash() const;
+
+  //! same as ATV::getId of the materialized ATV
+  ATV::id_t getId() const;
+
+  //! decode owning ATV
+  ATV toATV() const;
+
+  static ATVView fromVbkEncoding(ReadStream& stream);
+
+  static ATVView fromVbkEncoding(Slice<const uint8_t> bytes);
+
+ private:
+  Slice<const uint8_t> data_;
+  Slice<const uint8_t> rawTx_;
+  Slice<const uint8_t> signature_;
+  Slice<const uint8_t> publicKey_;
+  VbkMerklePathView merklePath_;
+  Slice<const uint8_t> blockOfProof_;
+};
+
+//! View of VTB
+struct VTBView {
+  uint32_t version = 1;
+
+  //! whole VBK encoding of this VTB
+  Slice<const uint8_t> data() const { return data_; }
+
+  //! raw VbkPopTx, as hashed by VbkPopTx::getHash
+  Slice<const uint8_t> rawTransaction() const { return rawTx_; }
+  Slice<const uint8_t> signature() const { return signature_; }
+  Slice<const uint8_t> publicKey() const { return publicKey_; }
+  const VbkMerklePathView& merklePath() const { return merklePath_; }
+
+  //! raw BTC transaction, which contains PoP publication data
+  Slice<const uint8_t> bitcoinTransaction() const { return btcTx_; }
+  VbkBlock publishedBlock() const;
+  BtcBlock blockOfProof() const;
+  VbkBlock containingBlock() const;
+
+  uint256 getTransactionHash() const;
+
+  //! same as VTB::getId of the materialized VTB
+  VTB::id_t getId() const;
+
+  //! same as VTB::getStronglyEquivalencyId of the materialized VTB
+  VTB::id_t getStronglyEquivalencyId() const;
+
+  //! decode owning VTB
+  VTB toVTB() const;
+
+  static VTBView fromVbkEncoding(ReadStream& stream);
+
+  static VTBView fromVbkEncoding(Slice<const uint8_t> bytes);
+
+ private:
+  Slice<const uint8_t> data_;
+  Slice<const uint8_t> rawTx_;
+  Slice<const uint8_t> signature_;
+  Slice<const uint8_t> publicKey_;
+  VbkMerklePathView merklePath_;
+  Slice<const uint8_t> containingBlock_;
+
+  // located inside of rawTx_
+  Slice<const uint8_t> publishedBlock_;
+  Slice<const uint8_t> btcTx_;
+  Slice<const uint8_t> blockOfProof_;
+};
+
+//! View of PopData
+struct PopDataView {
+  uint32_t version = 1;
+  //! VBK headers are fixed-size, so they are decoded eagerly
+  std::vector<VbkBlock> context;
+  std::vector<VTBView> vtbs;
+  std::vector<ATVView> atvs;
+
+  bool empty() const { return context.empty() && atvs.empty() && vtbs.empty(); }
+
+  //! decode owning PopData
+  PopData toPopData() const;
+
+  static PopDataView fromVbkEncoding(ReadStream& stream);
+
+  static PopDataView fromVbkEncoding(Slice<const uint8_t> bytes);
+};
+
+}  // namespace altintegration
+
+#endif  // ALT_INTEGRATION_INCLUDE_VERIBLOCK_ENTITIES_POPDATA_VIEW_HPP_
@@ -52,6 +52,12 @@ struct PublicationData {
    * @param stream data stream to write into
    */
   void toRaw(WriteStream& stream) const;
+
+  /**
+   * Calculate size of basic byte format without serializing
+   * @return size of toRaw output in bytes
+   */
+  size_t estimateRawSize() const;
 };
 
 template <typename JsonValue>
@@ -39,6 +39,12 @@ struct VbkMerklePath {
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   /**
    * Calculate the hash of the vb merkle root
    * @return hash merkle root hash
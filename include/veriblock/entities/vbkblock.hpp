@@ -74,6 +74,12 @@ struct VbkBlock {
    */
   void toRaw(WriteStream& stream) const;
 
+  /**
+   * Calculate size of basic byte format without serializing
+   * @return size of toRaw output in bytes
+   */
+  size_t estimateRawSize() const;
+
   /**
    * Convert VbkBlock to raw bytes data using VbkBlock byte format
    * @return bytes data
@@ -98,6 +104,12 @@ struct VbkBlock {
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   /*
    * Getter for difficulty
    * @return block difficulty
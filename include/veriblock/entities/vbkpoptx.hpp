@@ -60,12 +60,24 @@ struct VbkPopTx {
    */
   void toRaw(WriteStream& stream) const;
 
+  /**
+   * Calculate size of basic byte format without serializing
+   * @return size of toRaw output in bytes
+   */
+  size_t estimateRawSize() const;
+
   /**
    * Convert VbkPopTx to data stream using VbkPopTx VBK byte format
    * @param stream data stream to write into
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   /**
    * Calculate the hash of the vbk pop transaction
    * @return hash vbk pop transaction hash
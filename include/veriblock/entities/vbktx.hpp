@@ -59,12 +59,24 @@ struct VbkTx {
    */
   void toRaw(WriteStream& stream) const;
 
+  /**
+   * Calculate size of basic byte format without serializing
+   * @return size of toRaw output in bytes
+   */
+  size_t estimateRawSize() const;
+
   /**
    * Convert VbkTx to data stream using VbkTx VBK byte format
    * @param stream data stream to write into
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   /**
    * Calculate the hash of the vbk transaction
    * @return hash vbk transaction hash
@@ -26,7 +26,8 @@ struct VTB {
   VbkMerklePath merklePath{};
   containing_block_t containingBlock{};
 
-  //! (memory only) indicates whether we already did 'checkPayloads' on this VTB
+  //! (memory only) indicates whether we already did 'checkVTB' on this VTB.
+  //! Copies of this VTB are served by StatelessValidationCache instead.
   mutable bool checked{false};
 
   std::string toHex() const { return HexStr(toVbkEncoding()); }
@@ -60,6 +61,12 @@ struct VTB {
    */
   void toVbkEncoding(WriteStream& stream) const;
 
+  /**
+   * Calculate size of VBK encoding without serializing
+   * @return size of toVbkEncoding output in bytes
+   */
+  size_t estimateSize() const;
+
   static VTB fromHex(const std::string& hex);
 
   /**
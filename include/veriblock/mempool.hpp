@@ -6,26 +6,68 @@
 #ifndef ALT_INTEGRATION_VERIBLOCK_MEMPOOL_HPP
 #define ALT_INTEGRATION_VERIBLOCK_MEMPOOL_HPP
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
+#include "veriblock/algorithm.hpp"
 #include "veriblock/blockchain/alt_block_tree.hpp"
 #include "veriblock/blockchain/alt_chain_params.hpp"
 #include "veriblock/blockchain/btc_chain_params.hpp"
 #include "veriblock/blockchain/vbk_chain_params.hpp"
 #include "veriblock/entities/atv.hpp"
 #include "veriblock/entities/popdata.hpp"
+#include "veriblock/entities/popdata_view.hpp"
 #include "veriblock/entities/vtb.hpp"
 #include "veriblock/mempool_result.hpp"
 #include "veriblock/signals.hpp"
+#include "veriblock/thread_pool.hpp"
 
 namespace altintegration {
 
+/**
+ * Storage of POP payloads, which are not yet added to ALT blocks.
+ *
+ * submit, submitAll, getPop, removePayloads, clear and setMaxSize may be
+ * called concurrently. Stateless validation in submit is done on the calling
+ * thread without any lock, then contextual validation and insertion are done
+ * in a short critical section. Accept signals are emitted after the lock is
+ * released.
+ *
+ * get, getMap and ToJSON read an immutable Snapshot without taking any lock.
+ * Every modification publishes a new Snapshot, which shares unchanged maps
+ * with the previous one.
+ *
+ * VBK blocks, which do not connect to VBK tree or to VBK blocks in mempool,
+ * and VTBs, which BTC context does not connect to BTC tree or to BTC blocks
+ * of VTBs in mempool, are kept in a bounded pool of orphans and submit
+ * returns false for them with "-orphan" reason. Orphans are admitted in
+ * dependency order as soon as their parent is added to mempool or connected
+ * in ALT block. Orphans, which are too old, are dropped by removePayloads.
+ *
+ * @warning AltTree must not be modified concurrently with MemPool calls, and
+ * signal handlers must be connected before MemPool is used concurrently.
+ */
 struct MemPool {
   using vbk_hash_t = typename VbkBlock::prev_hash_t;
 
+  //! payload handle with its serialized size, which is cached at submit time
+  template <typename Payload>
+  struct SizedPayload {
+    SizedPayload(std::shared_ptr<Payload> p)
+        : payload(std::move(p)), size(payload->estimateSize()) {}
+
+    std::shared_ptr<Payload> payload;
+    size_t size;
+
+    Payload& operator*() const { return *payload; }
+    Payload* operator->() const { return payload.get(); }
+  };
+
   struct VbkPayloadsRelations {
     using id_t = VbkBlock::id_t;
 
@@ -36,8 +78,8 @@ struct MemPool {
         : header(ptr_b) {}
 
     std::shared_ptr<VbkBlock> header;
-    std::vector<std::shared_ptr<VTB>> vtbs;
-    std::vector<std::shared_ptr<ATV>> atvs;
+    std::vector<SizedPayload<VTB>> vtbs;
+    std::vector<SizedPayload<ATV>> atvs;
 
     PopData toPopData() const;
 
@@ -56,15 +98,53 @@ struct MemPool {
   using vtb_map_t = payload_map<VTB>;
   using relations_map_t = payload_map<VbkPayloadsRelations>;
 
+  //! consistent state of stored VBK blocks and payloads
+  struct Snapshot {
+    std::shared_ptr<const vbkblock_map_t> vbkblocks;
+    std::shared_ptr<const atv_map_t> atvs;
+    std::shared_ptr<const vtb_map_t> vtbs;
+
+    template <typename T>
+    const payload_map<T>& getMap() const {
+      static_assert(sizeof(T) == 0, "Undefined type used in Snapshot::getMap");
+    }
+  };
+
+  //! read-only reference to a map of a Snapshot, which keeps it alive
+  template <typename T>
+  struct MapRef {
+    using map_t = payload_map<T>;
+    using const_iterator = typename map_t::const_iterator;
+
+    explicit MapRef(std::shared_ptr<const Snapshot> snapshot)
+        : snapshot_(std::move(snapshot)),
+          map_(&snapshot_->template getMap<T>()) {}
+
+    const map_t& get() const { return *map_; }
+    size_t size() const { return map_->size(); }
+    bool empty() const { return map_->empty(); }
+    size_t count(const typename T::id_t& id) const { return map_->count(id); }
+    const_iterator find(const typename T::id_t& id) const {
+      return map_->find(id);
+    }
+    const_iterator begin() const { return map_->begin(); }
+    const_iterator end() const { return map_->end(); }
+
+   private:
+    std::shared_ptr<const Snapshot> snapshot_;
+    const map_t* map_;
+  };
+
   ~MemPool() = default;
-  MemPool(AltTree& tree) : tree_(&tree) {}
+  MemPool(AltTree& tree) : tree_(&tree) { publish(); }
 
   template <typename T>
-  const T* get(const typename T::id_t& id) const {
-    const auto& map = getMap<T>();
+  std::shared_ptr<const T> get(const typename T::id_t& id) const {
+    auto snapshot = getSnapshot();
+    const auto& map = snapshot->template getMap<T>();
     auto it = map.find(id);
     if (it != map.end()) {
-      return it->second.get();
+      return it->second;
     }
 
     return nullptr;
@@ -81,15 +161,89 @@ struct MemPool {
     return true;
   }
 
+  /**
+   * Submit all payloads from `pop`.
+   *
+   * Stateless checks of all VTBs and ATVs are done in a single batch (see
+   * checkVTBs, checkATVs), which is much faster than submitting payloads one
+   * by one.
+   */
   MempoolResult submitAll(const PopData& pop);
 
+  /**
+   * Submit all payloads from VBK-encoded PopData.
+   *
+   * Encoding is walked once with PopDataView. ATVs and VTBs, which are
+   * already stored, are reported valid without being decoded or validated
+   * again, the rest is decoded and submitted with submitAll(const PopData&).
+   *
+   * @throws std::exception if encoding is malformed, like
+   * PopData::fromVbkEncoding
+   */
+  MempoolResult submitAll(Slice<const uint8_t> encodedPopData);
+
+  //! workers used for batch stateless validation. nullptr disables
+  //! parallel validation.
+  void setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    pool_ = std::move(pool);
+  }
+
+  //! memory usage and eviction counters
+  struct Stats {
+    //! serialized size of stored VBK blocks and payloads
+    size_t bytes = 0;
+    //! number of payloads evicted because of size limit
+    size_t evictedAtvs = 0;
+    size_t evictedVtbs = 0;
+    size_t evictedVbkBlocks = 0;
+    //! number of VBK blocks and VTBs waiting for their parent
+    size_t orphans = 0;
+  };
+
+  Stats getStats() const;
+
+  /**
+   * Limit serialized size of all stored VBK blocks and payloads. 0 means no
+   * limit.
+   *
+   * When limit is exceeded, payloads with the lowest priority are evicted:
+   * payloads attached to older VBK blocks first, larger payloads first among
+   * payloads attached to blocks at the same height. VBK blocks are evicted
+   * after their payloads. A payload or VBK block, which does not fit even
+   * after evicting everything with lower priority, is rejected with "-full"
+   * reason and does not change mempool state.
+   */
+  void setMaxSize(size_t bytes);
+
+  //! Snapshot of current state. Lock-free.
+  std::shared_ptr<const Snapshot> getSnapshot() const {
+    return std::atomic_load(&snapshot_);
+  }
+
+  //! stored payloads of type T, in current Snapshot. Lock-free, no copies.
   template <typename T>
-  const payload_map<T>& getMap() const {
-    static_assert(sizeof(T) == 0, "Undefined type used in MemPool::getMap");
+  MapRef<T> getMap() const {
+    return MapRef<T>(getSnapshot());
   }
 
+  /**
+   * Build the POP part of a block template.
+   *
+   * Relations are visited in ascending order of VBK block height. Every
+   * relation contributes its VBK block, then ATVs and VTBs which still fit
+   * into AltChainParams::getMaxPopDataSize(), using sizes cached at submit
+   * time. Only selected payloads are copied.
+   */
   PopData getPop();
 
+  /**
+   * Remove payloads from `v_popData`, which has just been connected, and
+   * payloads which became stale.
+   *
+   * If ALT tip has moved by at most one block since previous call, only
+   * relations touched by `v_popData` and expired payloads are processed,
+   * using height-ordered indexes. Otherwise all relations are rechecked.
+   */
   void removePayloads(const PopData& v_popData);
 
   void clear();
@@ -102,16 +256,88 @@ struct MemPool {
 
  private:
   AltTree* tree_;
+  std::shared_ptr<ThreadPool> pool_;
+  // guards all state below
+  mutable std::mutex mutex_;
+  // published snapshot, accessed with std::atomic_load/atomic_store
+  std::shared_ptr<const Snapshot> snapshot_;
+  // maps, which have changed since snapshot_ was published
+  bool vbkblocks_changed_ = true;
+  bool atvs_changed_ = true;
+  bool vtbs_changed_ = true;
   // relations between VBK block and payloads
   relations_map_t relations_;
+  // relations_ keys ordered by height of VBK block, used by getPop
+  std::set<std::pair<int32_t, VbkBlock::id_t>> relations_by_height_;
   vbkblock_map_t vbkblocks_;
   atv_map_t stored_atvs_;
   vtb_map_t stored_vtbs_;
+  // relations holding VTBs, by VTB strong id. Strongly equivalent VTBs may
+  // be stored in several relations.
+  std::multimap<VTB::id_t, VbkBlock::id_t> vtb_relations_;
+  // ATV strong ids ordered by ALT tip height at which ATV expires. Entries of
+  // removed ATVs are skipped lazily.
+  std::set<std::pair<int32_t, ATV::id_t>> atvs_by_expiry_;
+  // strong ids of ATVs which endorse ALT blocks unknown to the tree
+  std::set<ATV::id_t> atvs_unknown_endorsed_;
+  // ALT tip at previous removePayloads call
+  AltBlock::hash_t vacuum_tip_;
+
+  // eviction order of stored VBK blocks and payloads, lowest priority first
+  struct PriorityKey {
+    enum class Kind : uint8_t { ATV = 0, VTB = 1, VBK_BLOCK = 2 };
+
+    int32_t height;
+    size_t size;
+    Kind kind;
+    VbkBlock::id_t relation;
+    // getId of payload, which is unique within relation. Empty for VBK block
+    // of the relation itself.
+    uint256 id;
+
+    bool operator<(const PriorityKey& o) const {
+      if (height != o.height) return height < o.height;
+      if (size != o.size) return size > o.size;
+      if (kind != o.kind) return kind < o.kind;
+      if (relation != o.relation) return relation < o.relation;
+      return id < o.id;
+    }
+  };
+  std::set<PriorityKey> by_priority_;
+  size_t max_size_ = 0;
+  Stats stats_;
+
+  // orphans keyed by id of missing VBK block (VbkBlock::previousBlock)
+  std::multimap<VbkBlock::id_t, VbkBlock> orphan_vbkblocks_;
+  // orphans keyed by hash of missing BTC block, to which VTB connects
+  std::multimap<uint256, VTB> orphan_vtbs_;
+  // number of stored VTBs, which contain BTC block with given hash
+  std::unordered_map<uint256, size_t> btc_provided_;
+  // recently added parents, orphans of which should be admitted
+  std::vector<VbkBlock::id_t> new_vbk_parents_;
+  std::vector<uint256> new_btc_parents_;
 
   signals::Signal<void(const ATV& atv)> on_atv_accepted;
   signals::Signal<void(const VTB& atv)> on_vtb_accepted;
   signals::Signal<void(const VbkBlock& atv)> on_vbkblock_accepted;
 
+  // accepted payloads, signals for which have not been emitted yet
+  std::vector<ATV> pending_atvs_;
+  std::vector<VTB> pending_vtbs_;
+  std::vector<VbkBlock> pending_vbkblocks_;
+
+  //! emit signals for pending payloads. Must be called without lock.
+  void emitAccepted();
+
+  //! publish new Snapshot, copying only changed maps. Must be called under
+  //! lock after every modification.
+  void publish();
+
+  //! contextual validation and insertion of statelessly valid payload.
+  //! Must be called under lock.
+  template <typename T>
+  bool add(const T& pl, ValidationState& state, bool shouldDoContextualCheck);
+
   VbkPayloadsRelations& touchVbkBlock(const VbkBlock& block,
                                       VbkBlock::id_t id = VbkBlock::id_t());
 
@@ -120,8 +346,64 @@ struct MemPool {
     static_assert(sizeof(Pop) == 0, "Unknown type in getSignal");
   }
 
+  //! ids of payloads which have just been connected
+  struct VacuumContext {
+    VacuumContext(const PopData& pop)
+        : vbkblock_ids(make_idset(pop.context)),
+          vtb_ids(make_idset(pop.vtbs)),
+          vtb_strong_ids(make_idset<VTB>(pop.vtbs, get_strong_id<VTB>)),
+          atv_strong_ids(make_idset<ATV>(pop.atvs, get_strong_id<ATV>)) {}
+
+    std::set<VbkBlock::id_t> vbkblock_ids;
+    std::set<VTB::id_t> vtb_ids;
+    std::set<VTB::id_t> vtb_strong_ids;
+    std::set<ATV::id_t> atv_strong_ids;
+  };
+
+  relations_map_t::iterator removeRelation(relations_map_t::iterator it);
+
+  //! remove stale payloads from a single relation, and relation itself if
+  //! it is no longer needed. Returns iterator to the next relation.
+  relations_map_t::iterator cleanupRelation(relations_map_t::iterator it,
+                                            const VacuumContext& ctx);
+
+  //! add payload to relation `rel_id`, stored payloads and priority index
+  void remember(const VbkBlock::id_t& rel_id, const SizedPayload<VTB>& vtb);
+  void remember(const VbkBlock::id_t& rel_id, const SizedPayload<ATV>& atv);
+
+  //! remove payload of relation `rel` from stored payloads and priority
+  //! index. Caller removes it from relation.
+  void forget(const relations_map_t::value_type& rel,
+              const SizedPayload<VTB>& vtb);
+  void forget(const relations_map_t::value_type& rel,
+              const SizedPayload<ATV>& atv);
+
+  //! remove payload with given getId from relation `rel`
+  void eraseVTB(relations_map_t::iterator rel, const VTB::id_t& id);
+  void eraseATV(relations_map_t::iterator rel, const ATV::id_t& id);
+
+  //! evict lowest priority payloads until size limit is satisfied
+  void trim();
+
+  //! true if `bytes` more can be stored, evicting only entries with lower
+  //! priority than `key`
+  bool fits(const PriorityKey& key, size_t bytes) const;
+
+  //! add orphans of new parents, until no more parents appear. Must be
+  //! called under lock.
+  void admitOrphans();
+
+  //! drop orphans which can not be included anymore
+  void vacuumOrphans();
+
+  void indexATVExpiry(const ATV& atv);
+
+  //! recheck all relations
   void vacuum(const PopData& pop);
 
+  //! process only relations touched by `pop` and expired payloads
+  void evict(const PopData& pop);
+
   template <typename Pop>
   bool checkContextually(const Pop& payload, ValidationState& state);
 };
@@ -131,12 +413,15 @@ struct MemPool {
 template <> bool MemPool::submit(const ATV& atv, ValidationState& state, bool shouldDoContextualCheck);
 template <> bool MemPool::submit(const VTB& vtb, ValidationState& state, bool shouldDoContextualCheck);
 template <> bool MemPool::submit(const VbkBlock& block, ValidationState& state, bool shouldDoContextualCheck);
+template <> bool MemPool::add(const ATV& atv, ValidationState& state, bool shouldDoContextualCheck);
+template <> bool MemPool::add(const VTB& vtb, ValidationState& state, bool shouldDoContextualCheck);
+template <> bool MemPool::add(const VbkBlock& block, ValidationState& state, bool shouldDoContextualCheck);
 template <> bool MemPool::checkContextually<VTB>(const VTB& vtb, ValidationState& state);
 template <> bool MemPool::checkContextually<ATV>(const ATV& id, ValidationState& state);
 template <> bool MemPool::checkContextually<VbkBlock>(const VbkBlock& id, ValidationState& state);
-template <> const MemPool::payload_map<VbkBlock>& MemPool::getMap() const;
-template <> const MemPool::payload_map<ATV>& MemPool::getMap() const;
-template <> const MemPool::payload_map<VTB>& MemPool::getMap() const;
+template <> const MemPool::payload_map<VbkBlock>& MemPool::Snapshot::getMap() const;
+template <> const MemPool::payload_map<ATV>& MemPool::Snapshot::getMap() const;
+template <> const MemPool::payload_map<VTB>& MemPool::Snapshot::getMap() const;
 template <> signals::Signal<void(const ATV&)>& MemPool::getSignal();
 template <> signals::Signal<void(const VTB&)>& MemPool::getSignal();
 template <> signals::Signal<void(const VbkBlock&)>& MemPool::getSignal();
@@ -145,9 +430,11 @@ template <> signals::Signal<void(const VbkBlock&)>& MemPool::getSignal();
 namespace detail {
 
 template <typename Value, typename T>
-inline void mapToJson(Value& obj, const MemPool& mp, const std::string& key) {
+inline void mapToJson(Value& obj,
+                      const MemPool::Snapshot& snapshot,
+                      const std::string& key) {
   auto arr = json::makeEmptyArray<Value>();
-  for (auto& p : mp.getMap<T>()) {
+  for (auto& p : snapshot.getMap<T>()) {
     json::arrayPushBack(arr, ToJSON<Value>(p.first));
   }
   json::putKV(obj, key, arr);
@@ -157,10 +444,11 @@ inline void mapToJson(Value& obj, const MemPool& mp, const std::string& key) {
 template <typename Value>
 Value ToJSON(const MemPool& mp) {
   auto obj = json::makeEmptyObject<Value>();
+  auto snapshot = mp.getSnapshot();
 
-  detail::mapToJson<Value, VbkBlock>(obj, mp, "vbkblocks");
-  detail::mapToJson<Value, ATV>(obj, mp, "atvs");
-  detail::mapToJson<Value, VTB>(obj, mp, "vtbs");
+  detail::mapToJson<Value, VbkBlock>(obj, *snapshot, "vbkblocks");
+  detail::mapToJson<Value, ATV>(obj, *snapshot, "atvs");
+  detail::mapToJson<Value, VTB>(obj, *snapshot, "vtbs");
 
   return obj;
 }
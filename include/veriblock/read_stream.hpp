@@ -10,6 +10,8 @@
 #include <type_traits>
 #include <vector>
 
+#include "blob.hpp"
+#include "endian.hpp"
 #include "slice.hpp"
 
 namespace altintegration {
@@ -55,6 +57,22 @@ class ReadStream {
     return result;
   }
 
+  /**
+   * Read 'size' bytes into caller-provided memory, without allocations.
+   * @param size bytes to be read
+   * @param out destination, must hold at least 'size' bytes
+   */
+  void read(size_t size, void *out);
+
+  /**
+   * Fill existing Blob in place with next N bytes.
+   * @param out destination blob
+   */
+  template <size_t N>
+  void read(Blob<N> &out) {
+    read(N, out.data());
+  }
+
   Slice<const uint8_t> readSlice(size_t size);
 
   // big endian
@@ -65,11 +83,8 @@ class ReadStream {
     if (!hasMore(sizeof(T))) {
       throw std::out_of_range("stream.readSingleBEValue(): out of data");
     }
-    T t = 0;
-    for (size_t i = 0, shift = (sizeof(T) - 1) * 8; i < sizeof(T);
-         i++, shift -= 8) {
-      t += ((T)m_Buffer[m_Pos++]) << shift;
-    }
+    T t = endian::loadBE<T>(m_Buffer + m_Pos);
+    m_Pos += sizeof(T);
     return t;
   }
 
@@ -81,10 +96,8 @@ class ReadStream {
     if (!hasMore(sizeof(T))) {
       throw std::out_of_range("stream.readLE(): out of data");
     }
-    T t = 0;
-    for (size_t i = 0, shift = 0; i < sizeof(T); i++, shift += 8) {
-      t += m_Buffer[m_Pos++] << shift;
-    }
+    T t = endian::loadLE<T>(m_Buffer + m_Pos);
+    m_Pos += sizeof(T);
     return t;
   }
 
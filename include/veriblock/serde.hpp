@@ -106,9 +106,14 @@ Slice<const uint8_t> readSingleByteLenValue(
 template <typename T,
           typename = typename std::enable_if<std::is_integral<T>::value>::type>
 T readSingleBEValue(ReadStream& stream) {
-  return ReadStream(
-             pad(readSingleByteLenValue(stream, 0, sizeof(T)), sizeof(T)))
-      .readBE<T>();
+  using unsigned_t = typename std::make_unsigned<T>::type;
+  auto data = readSingleByteLenValue(stream, 0, sizeof(T));
+  // missing leading bytes are zeroes
+  unsigned_t value = 0;
+  for (const auto& byte : data) {
+    value = (unsigned_t)((value << 8u) | byte);
+  }
+  return (T)value;
 }
 
 /**
@@ -142,9 +147,8 @@ void writeSingleBEValue(WriteStream& stream, int64_t value);
 template <typename T,
           typename = typename std::enable_if<std::is_integral<T>::value>::type>
 void writeSingleFixedBEValue(WriteStream& stream, T value) {
-  WriteStream dataStream;
-  dataStream.writeBE<T>(value);
-  writeSingleByteLenValue(stream, dataStream.data());
+  stream.writeBE<uint8_t>((uint8_t)sizeof(T));
+  stream.writeBE<T>(value);
 }
 
 /**
@@ -157,6 +161,61 @@ void writeSingleFixedBEValue(WriteStream& stream, T value) {
  */
 void writeVarLenValue(WriteStream& stream, Slice<const uint8_t> value);
 
+/**
+ * Write unsigned integer as a variable-length quantity (LEB128): 7 bits per
+ * byte, least significant group first, high bit set on every byte but the
+ * last. Values below 128 take a single byte.
+ * @param stream write data to this stream
+ * @param value value to be written
+ */
+void writeVarInt(WriteStream& stream, uint64_t value);
+
+/**
+ * Read unsigned integer written by writeVarInt
+ * @param stream read data from this stream
+ * @throws std::out_of_range if stream is out of data or value does not fit
+ * into 64 bits
+ * @return read number
+ */
+uint64_t readVarInt(ReadStream& stream);
+
+/**
+ * Number of bytes written by writeVarInt
+ * @param value value to be written
+ */
+size_t varIntSize(uint64_t value);
+
+/**
+ * Number of bytes written by writeSingleBEValue
+ * @param value value to be written
+ */
+size_t singleBEValueSize(int64_t value);
+
+/**
+ * Number of bytes written by writeSingleFixedBEValue<T>
+ */
+template <typename T,
+          typename = typename std::enable_if<std::is_integral<T>::value>::type>
+constexpr size_t singleFixedBEValueSize() {
+  return 1 + sizeof(T);
+}
+
+/**
+ * Number of bytes written by writeSingleByteLenValue
+ * @param valueSize size of data that should be written
+ */
+inline size_t singleByteLenValueSize(size_t valueSize) {
+  return 1 + valueSize;
+}
+
+/**
+ * Number of bytes written by writeVarLenValue
+ * @param valueSize size of data that should be written
+ */
+inline size_t varLenValueSize(size_t valueSize) {
+  return singleBEValueSize((int64_t)valueSize) + valueSize;
+}
+
 struct NetworkBytePair {
   ///< works as std::optional. if hasNetworkByte is true, networkByte is set
   bool hasNetworkByte = false;
@@ -242,6 +301,38 @@ void writeArrayOf(WriteStream& w,
   return writeContainer<std::vector<T>>(w, t, f);
 }
 
+/**
+ * Write array of fixed-size blobs as `[varint N | N blobs without length]`
+ * @param w write data to this stream
+ * @param v blobs to be written
+ */
+template <size_t N>
+void writeCompactArrayOf(WriteStream& w, const std::vector<Blob<N>>& v) {
+  writeVarInt(w, v.size());
+  for (const auto& b : v) {
+    w.write(b);
+  }
+}
+
+/**
+ * Read array of fixed-size blobs written by writeCompactArrayOf
+ * @param r read data from this stream
+ * @throws std::out_of_range if stream is out of data
+ * @return vector of read blobs
+ */
+template <size_t N>
+std::vector<Blob<N>> readCompactArrayOf(ReadStream& r) {
+  const auto count = readVarInt(r);
+  if (count > r.remaining() / N) {
+    throw std::out_of_range("readCompactArrayOf(): out of data");
+  }
+  std::vector<Blob<N>> ret((size_t)count);
+  for (auto& b : ret) {
+    r.read(b);
+  }
+  return ret;
+}
+
 template <typename T>
 T fromRaw(const std::vector<uint8_t>& bytes) {
   ReadStream r(bytes);
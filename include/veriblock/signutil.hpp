@@ -6,6 +6,7 @@
 #ifndef __SIGNUTIL__HPP__
 #define __SIGNUTIL__HPP__
 
+#include <cstdint>
 #include <stdexcept>
 #include <vector>
 #include "slice.hpp"
@@ -86,6 +87,37 @@ int veriBlockVerify(Slice<const uint8_t> message,
                     Signature signature,
                     PublicKey publicKey);
 
+/**
+ * Public key, parsed into the internal secp256k1 representation.
+ * Opaque, use parsePublicKeyVbk to create.
+ */
+struct ParsedPublicKey {
+  uint8_t data[64];
+};
+
+/**
+ * Parse VBK encoded public key into the internal secp256k1 representation.
+ * Parsed keys are kept in a bounded process-wide cache keyed by the encoded
+ * key bytes, so a key used by many transactions is parsed only once.
+ * Thread-safe.
+ * @param key VBK encoded public key
+ * @param[out] out parsed key
+ * @return true if key was parsed, false if key is malformed
+ */
+bool parsePublicKeyVbk(Slice<const uint8_t> key, ParsedPublicKey& out);
+
+/**
+ * Verify message previously signed with veriBlockSign, using already parsed
+ * public key. Thread-safe.
+ * @param message message to verify with
+ * @param signature VBK encoded signature to verify
+ * @param publicKey verify signature with this public key
+ * @return 1 if signature is valid, 0 - otherwise
+ */
+int veriBlockVerify(Slice<const uint8_t> message,
+                    Slice<const uint8_t> signature,
+                    const ParsedPublicKey& publicKey);
+
 }  // namespace altintegration
 
 #endif  //__SIGNUTIL__HPP__
@@ -16,6 +16,8 @@
 #include "veriblock/entities/vbkblock.hpp"
 #include "veriblock/entities/vtb.hpp"
 #include "veriblock/signutil.hpp"
+#include "veriblock/stateless_validation_cache.hpp"
+#include "veriblock/thread_pool.hpp"
 #include "veriblock/time.hpp"
 
 namespace altintegration {
@@ -47,6 +49,25 @@ bool checkSignature(const VbkTx& tx, ValidationState& state);
 
 bool checkSignature(const VbkPopTx& tx, ValidationState& state);
 
+/**
+ * Verify signatures of a batch of VBK transactions.
+ *
+ * Public keys are parsed and matched against source addresses once per
+ * distinct key, then signatures are verified in parallel on `pool`.
+ * @param[in] txes transactions to verify
+ * @param[out] states validation state of every tx, in the order of `txes`
+ * @param[in] pool workers, or nullptr to verify on the calling thread
+ * @return true if all signatures are valid
+ */
+bool checkSignatures(Slice<const VbkTx* const> txes,
+                     std::vector<ValidationState>& states,
+                     ThreadPool* pool = nullptr);
+
+//! @overload
+bool checkSignatures(Slice<const VbkPopTx* const> txes,
+                     std::vector<ValidationState>& states,
+                     ThreadPool* pool = nullptr);
+
 bool checkBtcBlocks(const std::vector<BtcBlock>& btcBlocks,
                     ValidationState& state,
                     const BtcChainParams& param);
@@ -83,6 +104,38 @@ bool checkATV(const ATV& atv,
 bool checkVTB(const VTB& vtb,
               ValidationState& state,
               const BtcChainParams& btc);
+
+/**
+ * Statelessly check a batch of ATVs.
+ *
+ * Equivalent to calling checkATV on every ATV, but signatures are verified
+ * with checkSignatures and the remaining checks run on `pool` as well.
+ * @param[in] atvs ATVs to check
+ * @param[out] states validation state of every ATV, in the order of `atvs`
+ * @param[in] alt altchain params
+ * @param[in] pool workers, or nullptr to check on the calling thread
+ * @return true if all ATVs are valid
+ */
+bool checkATVs(const std::vector<ATV>& atvs,
+               std::vector<ValidationState>& states,
+               const AltChainParams& alt,
+               ThreadPool* pool = nullptr);
+
+/**
+ * Statelessly check a batch of VTBs.
+ *
+ * Equivalent to calling checkVTB on every VTB, but signatures are verified
+ * with checkSignatures and the remaining checks run on `pool` as well.
+ * @param[in] vtbs VTBs to check
+ * @param[out] states validation state of every VTB, in the order of `vtbs`
+ * @param[in] btc BTC chain params
+ * @param[in] pool workers, or nullptr to check on the calling thread
+ * @return true if all VTBs are valid
+ */
+bool checkVTBs(const std::vector<VTB>& vtbs,
+               std::vector<ValidationState>& states,
+               const BtcChainParams& btc,
+               ThreadPool* pool = nullptr);
 }  // namespace altintegration
 
 #endif  // ! ALT_INTEGRATION_INCLUDE_VERIBLOCK_STATELESS_VALIDATION_H
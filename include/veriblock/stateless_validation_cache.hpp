@@ -0,0 +1,66 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef VERIBLOCK_POP_CPP_STATELESS_VALIDATION_CACHE_HPP
+#define VERIBLOCK_POP_CPP_STATELESS_VALIDATION_CACHE_HPP
+
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+#include "veriblock/uint.hpp"
+
+namespace altintegration {
+
+//! default max number of entries in StatelessValidationCache
+static const size_t DEFAULT_STATELESS_VALIDATION_CACHE_SIZE = 50000;
+
+/**
+ * Bounded, thread-safe set of keys of payloads, which passed stateless
+ * validation. Similar to Bitcoin's signature cache.
+ *
+ * Only successful validations are stored. A key is derived from the payload
+ * id (or tx hash), the fields which it does not commit to, and chain params
+ * that affect validation, so the same payload checked against different
+ * params is validated again. When the cache is full, the oldest entries are
+ * evicted first.
+ */
+struct StatelessValidationCache {
+  using key_t = uint256;
+
+  explicit StatelessValidationCache(
+      size_t maxSize = DEFAULT_STATELESS_VALIDATION_CACHE_SIZE)
+      : maxSize_(maxSize) {}
+
+  //! @return true if `key` has been marked as valid
+  bool contains(const key_t& key) const;
+
+  //! mark `key` as valid
+  void insert(const key_t& key);
+
+  //! forget all entries
+  void clear();
+
+  size_t size() const;
+
+  //! change max number of entries. Evicts oldest entries if needed.
+  void setMaxSize(size_t maxSize);
+
+ private:
+  mutable std::mutex mutex_;
+  size_t maxSize_;
+  std::unordered_set<key_t> keys_;
+  // insertion order, used for eviction
+  std::deque<key_t> order_;
+
+  void truncate();
+};
+
+//! process-wide cache used by checkATV, checkVTB and their batch versions
+StatelessValidationCache& getStatelessValidationCache();
+
+}  // namespace altintegration
+
+#endif  // VERIBLOCK_POP_CPP_STATELESS_VALIDATION_CACHE_HPP
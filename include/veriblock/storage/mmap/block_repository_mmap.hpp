@@ -0,0 +1,463 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef ALT_INTEGRATION_INCLUDE_VERIBLOCK_STORAGE_MMAP_BLOCK_REPOSITORY_MMAP_HPP_
+#define ALT_INTEGRATION_INCLUDE_VERIBLOCK_STORAGE_MMAP_BLOCK_REPOSITORY_MMAP_HPP_
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <veriblock/serde.hpp>
+#include <veriblock/storage/block_repository.hpp>
+#include <veriblock/storage/db_error.hpp>
+#include <veriblock/storage/mmap/mapped_file.hpp>
+
+namespace altintegration {
+
+template <typename Block>
+struct BlockRepositoryMmap;
+
+template <typename Block>
+struct BlockCursorMmap : public Cursor<typename Block::hash_t, Block> {
+  //! stored block type
+  using stored_block_t = Block;
+  //! block has type
+  using hash_t = typename Block::hash_t;
+  //! {record offset, block hash}
+  using record_t = std::pair<size_t, hash_t>;
+
+  BlockCursorMmap(BlockRepositoryMmap<Block>& repo,
+                  std::vector<record_t> records)
+      : _repo(repo), _records(std::move(records)) {}
+  ~BlockCursorMmap() override = default;
+
+  void seekToFirst() override { _pos = 0; }
+  void seek(const hash_t& key) override {
+    auto it = std::find_if(_records.begin(),
+                           _records.end(),
+                           [&key](const record_t& r) { return r.second == key; });
+    _pos = (size_t)std::distance(_records.begin(), it);
+  }
+  void seekToLast() override {
+    _pos = _records.empty() ? _records.size() : _records.size() - 1;
+  }
+  bool isValid() const override { return _pos < _records.size(); }
+  void next() override {
+    if (_pos < _records.size()) {
+      ++_pos;
+    }
+  }
+  void prev() override {
+    _pos = _pos == 0 ? _records.size() : _pos - 1;
+  }
+  hash_t key() const override {
+    VBK_ASSERT(isValid() && "invalid cursor");
+    return _records[_pos].second;
+  }
+  stored_block_t value() const override {
+    VBK_ASSERT(isValid() && "invalid cursor");
+    return _repo.readBlock(_records[_pos].first);
+  }
+
+ private:
+  BlockRepositoryMmap<Block>& _repo;
+  std::vector<record_t> _records;
+  size_t _pos = 0;
+};
+
+template <typename Block>
+struct BlockWriteBatchMmap : public BlockWriteBatch<Block> {
+  //! stored block type
+  using stored_block_t = Block;
+  //! block has type
+  using hash_t = typename Block::hash_t;
+
+  BlockWriteBatchMmap(BlockRepositoryMmap<stored_block_t>* repo)
+      : _repo(repo) {}
+
+  void put(const stored_block_t& block) override { _puts.push_back(block); }
+
+  void removeByHash(const hash_t& hash) override {
+    // removals are applied before puts of the following blocks
+    _ops.push_back({_puts.size(), hash});
+  }
+
+  void clear() override {
+    _puts.clear();
+    _ops.clear();
+  }
+
+  void commit() override {
+    size_t begin = 0;
+    for (const auto& op : _ops) {
+      _repo->putMany(_puts.begin() + begin, _puts.begin() + op.first);
+      _repo->removeByHash(op.second);
+      begin = op.first;
+    }
+    _repo->putMany(_puts.begin() + begin, _puts.end());
+    clear();
+  }
+
+ private:
+  BlockRepositoryMmap<stored_block_t>* _repo;
+  std::vector<stored_block_t> _puts;
+  //! {number of puts before this removal, removed hash}
+  std::vector<std::pair<size_t, hash_t>> _ops;
+};
+
+/**
+ * @class BlockRepositoryMmap
+ *
+ * @brief Append-only block store, read through a memory mapping.
+ *
+ * Blocks are appended to `<path>.dat` as records
+ * `[type | height | hash | uint32 size | block in compact encoding]`. Each
+ * batch is appended in height order, and the cursor iterates blocks in
+ * height order. A newer record of the same block supersedes the older one,
+ * and a tombstone record removes the block.
+ *
+ * The hash to offset index lives in memory and is saved to the sidecar file
+ * `<path>.idx` on flush(). On open, the sidecar is loaded, and only records
+ * appended after the last flush are scanned. Neither step deserializes
+ * blocks. A torn record at the end of the file is truncated.
+ *
+ * Superseded records are reclaimed by compact().
+ *
+ * Designed for BTC and VBK block indexes with millions of headers.
+ *
+ * @invariant NOT thread-safe.
+ */
+template <typename Block>
+struct BlockRepositoryMmap : public BlockRepository<Block> {
+  //! stored block type
+  using stored_block_t = Block;
+  //! block has type
+  using hash_t = typename Block::hash_t;
+  //! block height type
+  using height_t = typename Block::height_t;
+  //! iterator type
+  using cursor_t = Cursor<hash_t, stored_block_t>;
+
+  explicit BlockRepositoryMmap(std::string path) : _path(std::move(path)) {
+    open();
+  }
+
+  ~BlockRepositoryMmap() override {
+    try {
+      flush();
+    } catch (const std::exception&) {
+      // sidecar is optional, it is rebuilt from records on the next open
+    }
+  }
+
+  bool getByHash(const hash_t& hash, stored_block_t* out) const override {
+    auto it = _index.find(hash);
+    if (it == _index.end()) {
+      return false;
+    }
+
+    if (out) {
+      *out = readBlock(it->second.offset);
+    }
+    return true;
+  }
+
+  size_t getManyByHash(Slice<const hash_t> hashes,
+                       std::vector<stored_block_t>* out) const override {
+    size_t totalFound = 0;
+    for (const auto& h : hashes) {
+      stored_block_t block;
+      if (getByHash(h, &block)) {
+        ++totalFound;
+        out->push_back(block);
+      }
+    }
+
+    return totalFound;
+  }
+
+  bool put(const stored_block_t& block) override {
+    bool res = _index.count(block.getHash()) > 0;
+    putMany(&block, &block + 1);
+    return res;
+  }
+
+  bool removeByHash(const hash_t& hash) override {
+    auto it = _index.find(hash);
+    if (it == _index.end()) {
+      return false;
+    }
+
+    WriteStream w;
+    writeRecordHeader(w, TOMBSTONE, it->second.height, hash, 0);
+    append(w);
+    _index.erase(it);
+    return true;
+  }
+
+  void clear() override {
+    _data->truncate(0);
+    _end = 0;
+    _index.clear();
+    writeSidecar();
+  }
+
+  std::unique_ptr<BlockWriteBatch<stored_block_t>> newBatch() override {
+    return std::unique_ptr<BlockWriteBatchMmap<stored_block_t>>(
+        new BlockWriteBatchMmap<stored_block_t>(this));
+  }
+
+  std::shared_ptr<cursor_t> newCursor() override {
+    // {{height, offset}, hash}, offsets are unique
+    std::vector<std::pair<std::pair<height_t, size_t>, const hash_t*>> order;
+    order.reserve(_index.size());
+    for (const auto& e : _index) {
+      order.push_back({{e.second.height, e.second.offset}, &e.first});
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<typename BlockCursorMmap<stored_block_t>::record_t> records;
+    records.reserve(order.size());
+    for (const auto& o : order) {
+      records.push_back({o.first.second, *o.second});
+    }
+    return std::make_shared<BlockCursorMmap<stored_block_t>>(
+        *this, std::move(records));
+  }
+
+  //! append blocks [begin, end) in height order with a single write
+  template <typename It>
+  void putMany(It begin, It end) {
+    std::vector<const stored_block_t*> blocks;
+    for (auto it = begin; it != end; ++it) {
+      blocks.push_back(&*it);
+    }
+    std::stable_sort(
+        blocks.begin(),
+        blocks.end(),
+        [](const stored_block_t* a, const stored_block_t* b) {
+          return a->getHeight() < b->getHeight();
+        });
+
+    WriteStream w;
+    std::vector<std::pair<hash_t, Entry>> entries;
+    entries.reserve(blocks.size());
+    for (const auto* block : blocks) {
+      auto hash = block->getHash();
+      auto raw = block->toRaw();
+      entries.push_back({hash, Entry{_end + w.size(), block->getHeight()}});
+      writeRecordHeader(w, BLOCK, block->getHeight(), hash, raw.size());
+      w.write(raw);
+    }
+    append(w);
+    for (auto& e : entries) {
+      _index[e.first] = e.second;
+    }
+  }
+
+  //! sync records to disk and save the sidecar index
+  void flush() {
+    _data->sync();
+    writeSidecar();
+  }
+
+  //! rewrite the file with live records only, in height order
+  void compact() {
+    const auto tmpPath = dataPath() + ".tmp";
+    std::remove(tmpPath.c_str());
+    std::unordered_map<hash_t, Entry> index;
+    {
+      MappedFile tmp(tmpPath);
+      std::vector<std::pair<height_t, size_t>> order;
+      order.reserve(_index.size());
+      for (const auto& e : _index) {
+        order.push_back({e.second.height, e.second.offset});
+      }
+      std::sort(order.begin(), order.end());
+
+      size_t end = 0;
+      for (const auto& o : order) {
+        auto r = readRecord(o.second);
+        auto bytes = _data->read(o.second, r.size);
+        tmp.write(end, bytes.data(), bytes.size());
+        index[r.hash] = Entry{end, o.first};
+        end += bytes.size();
+      }
+      tmp.sync();
+    }
+
+    _data.reset();
+#ifdef _WIN32
+    std::remove(dataPath().c_str());
+#endif
+    if (std::rename(tmpPath.c_str(), dataPath().c_str()) != 0) {
+      _data.reset(new MappedFile(dataPath()));
+      throw db::StorageIOException("can not replace " + dataPath());
+    }
+    _data.reset(new MappedFile(dataPath()));
+    _end = _data->size();
+    _index = std::move(index);
+    writeSidecar();
+  }
+
+  //! physical size of the records file
+  size_t fileSize() const { return _data->size(); }
+
+  stored_block_t readBlock(size_t offset) const {
+    auto r = readRecord(offset);
+    VBK_ASSERT(r.type == BLOCK);
+    return stored_block_t::fromRaw(r.payload);
+  }
+
+ private:
+  enum RecordType : uint8_t { TOMBSTONE = 0, BLOCK = 1 };
+
+  struct Entry {
+    size_t offset;
+    height_t height;
+  };
+
+  struct Record {
+    uint8_t type;
+    height_t height;
+    hash_t hash;
+    Slice<const uint8_t> payload;
+    //! total size of the record
+    size_t size;
+  };
+
+  std::string dataPath() const { return _path + ".dat"; }
+  std::string sidecarPath() const { return _path + ".idx"; }
+
+  static void writeRecordHeader(WriteStream& w,
+                                RecordType type,
+                                height_t height,
+                                const hash_t& hash,
+                                size_t size) {
+    w.writeBE<uint8_t>(type);
+    w.writeLE<uint32_t>((uint32_t)height);
+    writeSingleByteLenValue(w, hash);
+    w.writeLE<uint32_t>((uint32_t)size);
+  }
+
+  //! @throws std::out_of_range if record is incomplete
+  Record readRecord(size_t offset) const {
+    auto bytes = _data->read(offset, _data->size() - offset);
+    ReadStream r(bytes);
+    Record ret;
+    ret.type = r.readBE<uint8_t>();
+    if (ret.type != TOMBSTONE && ret.type != BLOCK) {
+      throw std::out_of_range("unknown record type");
+    }
+    ret.height = (height_t)r.readLE<uint32_t>();
+    ret.hash = hash_t(readSingleByteLenValue(r).asVector());
+    ret.payload = r.readSlice(r.readLE<uint32_t>());
+    ret.size = r.position();
+    return ret;
+  }
+
+  void append(const WriteStream& w) {
+    auto bytes = w.slice();
+    _data->write(_end, bytes.data(), bytes.size());
+    _end += bytes.size();
+  }
+
+  void open() {
+    _data.reset(new MappedFile(dataPath()));
+    _index.clear();
+    _end = 0;
+    readSidecar();
+
+    // replay records appended after the sidecar was written
+    while (_end < _data->size()) {
+      Record r;
+      try {
+        r = readRecord(_end);
+      } catch (const std::out_of_range&) {
+        // torn write, it will be overwritten
+        break;
+      }
+      if (r.type == BLOCK) {
+        _index[r.hash] = Entry{_end, r.height};
+      } else {
+        _index.erase(r.hash);
+      }
+      _end += r.size;
+    }
+    if (_end < _data->size()) {
+      // drop torn tail, so that it can not be mistaken for records later
+      _data->truncate(_end);
+    }
+  }
+
+  // [uint64 covered size | uint64 N | N x (hash | uint64 offset | height)]
+  void writeSidecar() const {
+    WriteStream w;
+    w.writeLE<uint64_t>(_end);
+    w.writeLE<uint64_t>(_index.size());
+    for (const auto& e : _index) {
+      writeSingleByteLenValue(w, e.first);
+      w.writeLE<uint64_t>(e.second.offset);
+      w.writeLE<uint32_t>((uint32_t)e.second.height);
+    }
+
+    const auto tmpPath = sidecarPath() + ".tmp";
+    {
+      std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+      auto bytes = w.slice();
+      out.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+      if (!out) {
+        throw db::StorageIOException("can not write " + tmpPath);
+      }
+    }
+    std::remove(sidecarPath().c_str());
+    if (std::rename(tmpPath.c_str(), sidecarPath().c_str()) != 0) {
+      throw db::StorageIOException("can not replace " + sidecarPath());
+    }
+  }
+
+  void readSidecar() {
+    std::ifstream in(sidecarPath(), std::ios::binary);
+    if (!in) {
+      return;
+    }
+    std::vector<uint8_t> bytes{std::istreambuf_iterator<char>(in),
+                               std::istreambuf_iterator<char>()};
+    try {
+      ReadStream r(bytes);
+      const auto covered = r.readLE<uint64_t>();
+      if (covered > _data->size()) {
+        throw std::out_of_range("sidecar is ahead of records");
+      }
+      const auto count = r.readLE<uint64_t>();
+      for (uint64_t i = 0; i < count; ++i) {
+        auto hash = hash_t(readSingleByteLenValue(r).asVector());
+        const auto offset = r.readLE<uint64_t>();
+        const auto height = (height_t)r.readLE<uint32_t>();
+        if (offset >= covered) {
+          throw std::out_of_range("sidecar offset is out of range");
+        }
+        _index[hash] = Entry{(size_t)offset, height};
+      }
+      _end = (size_t)covered;
+    } catch (const std::out_of_range&) {
+      // broken sidecar, rebuild index from records
+      _index.clear();
+      _end = 0;
+    }
+  }
+
+  std::string _path;
+  std::unique_ptr<MappedFile> _data;
+  //! offset of the next record
+  size_t _end = 0;
+  std::unordered_map<hash_t, Entry> _index;
+};
+
+}  // namespace altintegration
+
+#endif  // ALT_INTEGRATION_INCLUDE_VERIBLOCK_STORAGE_MMAP_BLOCK_REPOSITORY_MMAP_HPP_
@@ -0,0 +1,71 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef ALT_INTEGRATION_INCLUDE_VERIBLOCK_STORAGE_MMAP_MAPPED_FILE_HPP_
+#define ALT_INTEGRATION_INCLUDE_VERIBLOCK_STORAGE_MMAP_MAPPED_FILE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <veriblock/slice.hpp>
+
+namespace altintegration {
+
+/**
+ * @class MappedFile
+ *
+ * @brief Growable file, which is read through a read-only memory mapping.
+ *
+ * Writes go through the file descriptor. The mapping is extended lazily, when
+ * a read touches bytes written after the last mapping.
+ *
+ * On platforms without POSIX mmap the file is mirrored in a heap buffer.
+ *
+ * @invariant NOT thread-safe.
+ * @throws db::StorageIOException on any I/O error
+ */
+class MappedFile {
+ public:
+  //! open or create file at `path`
+  explicit MappedFile(std::string path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  //! physical size of the file
+  size_t size() const { return size_; }
+
+  //! view of `size` bytes at `offset`; valid until the next write or truncate
+  Slice<const uint8_t> read(size_t offset, size_t size);
+
+  //! write `size` bytes at `offset`, the file grows if needed
+  void write(size_t offset, const void* data, size_t size);
+
+  //! shrink or extend file to `size` bytes
+  void truncate(size_t size);
+
+  //! flush written data to disk
+  void sync();
+
+  const std::string& path() const { return path_; }
+
+ private:
+  void unmap();
+
+  std::string path_;
+  size_t size_ = 0;
+  size_t mapped_ = 0;
+#ifdef _WIN32
+  std::vector<uint8_t> mirror_;
+#else
+  int fd_ = -1;
+  uint8_t* map_ = nullptr;
+#endif
+};
+
+}  // namespace altintegration
+
+#endif  // ALT_INTEGRATION_INCLUDE_VERIBLOCK_STORAGE_MMAP_MAPPED_FILE_HPP_
@@ -0,0 +1,88 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef VERIBLOCK_POP_CPP_THREAD_POOL_HPP
+#define VERIBLOCK_POP_CPP_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace altintegration {
+
+/**
+ * Fixed-size pool of worker threads.
+ *
+ * Used to spread CPU-heavy stateless work (signature verification, merkle
+ * paths, PoW checks) across cores. A pool with 0 workers executes all tasks
+ * inline on the calling thread, so callers never have to special-case
+ * "no pool".
+ */
+struct ThreadPool {
+  //! @param threads number of worker threads. 0 means "execute inline".
+  explicit ThreadPool(size_t threads = defaultConcurrency());
+
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  //! number of worker threads
+  size_t size() const { return workers_.size(); }
+
+  /**
+   * Execute `f(i)` for every i in [0, n).
+   *
+   * The calling thread participates in the work. Returns when all n calls
+   * have finished. If any call throws, the first exception is rethrown in the
+   * caller after all calls finished.
+   */
+  void parallelFor(size_t n, const std::function<void(size_t)>& f);
+
+  /**
+   * Schedule `f` for asynchronous execution.
+   * @return future, which becomes ready once `f` has been executed.
+   */
+  std::future<void> async(std::function<void()> f);
+
+  //! number of hardware threads, at least 1
+  static size_t defaultConcurrency();
+
+ private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_ = false;
+
+  void enqueue(std::function<void()> task);
+  void workerLoop();
+};
+
+/**
+ * Execute `f(i)` for every i in [0, n) on `pool`, or sequentially on the
+ * calling thread if `pool` is nullptr.
+ */
+inline void parallelFor(ThreadPool* pool,
+                        size_t n,
+                        const std::function<void(size_t)>& f) {
+  if (pool == nullptr) {
+    for (size_t i = 0; i < n; ++i) {
+      f(i);
+    }
+    return;
+  }
+
+  pool->parallelFor(n, f);
+}
+
+}  // namespace altintegration
+
+#endif  // VERIBLOCK_POP_CPP_THREAD_POOL_HPP
@@ -7,13 +7,23 @@
 #define ALT_INTEGRATION_VERIBLOCK_WRITE_STREAM_HPP
 
 #include <cstdint>
+#include <cstring>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "endian.hpp"
+#include "slice.hpp"
+
 namespace altintegration {
 
 /**
  * Binary writer that is useful during binary serialization.
+ *
+ * By default, stream owns a growing vector. Alternatively, it can target a
+ * caller-provided buffer (stack array, arena chunk, mmaped region): nothing is
+ * allocated then, and writing past the end of that buffer throws
+ * std::out_of_range.
  */
 class WriteStream {
  public:
@@ -23,9 +33,34 @@ class WriteStream {
 
   explicit WriteStream(size_t size) { m_data.reserve(size); }
 
+  //! write into external buffer `buf` of `capacity` bytes
+  WriteStream(void *buf, size_t capacity)
+      : m_external((uint8_t *)buf), m_capacity(capacity) {}
+
+  //! preallocate storage for `size` bytes in total
+  void reserve(size_t size) {
+    if (m_external == nullptr) {
+      m_data.reserve(size);
+    }
+  }
+
+  //! drop written bytes, keep allocated (or external) storage for reuse
+  void reset() noexcept {
+    m_data.clear();
+    m_size = 0;
+  }
+
   void write(const void *buf, size_t size) {
-    const uint8_t *inp = (uint8_t *)buf;
-    m_data.insert(m_data.end(), inp, inp + size);
+    const uint8_t *inp = (const uint8_t *)buf;
+    if (m_external == nullptr) {
+      m_data.insert(m_data.end(), inp, inp + size);
+      return;
+    }
+    if (m_capacity - m_size < size) {
+      throw std::out_of_range("stream.write(): out of buffer space");
+    }
+    std::memcpy(m_external + m_size, inp, size);
+    m_size += size;
   }
 
   template <typename T,
@@ -39,25 +74,45 @@ class WriteStream {
       typename T,
       typename = typename std::enable_if<std::is_integral<T>::value>::type>
   void writeBE(T num) {
-    for (size_t i = 0, shift = (sizeof(T) - 1) * 8; i < sizeof(T);
-         i++, shift -= 8) {
-      m_data.push_back((num >> shift) & 0xffu);
-    }
+    uint8_t buf[sizeof(T)];
+    endian::storeBE<T>(buf, num);
+    write(buf, sizeof(T));
   }
 
   template <
       typename T,
       typename = typename std::enable_if<std::is_integral<T>::value>::type>
   void writeLE(T num) {
-    for (size_t i = 0, shift = 0; i < sizeof(T); i++, shift += 8) {
-      m_data.push_back((num >> shift) & 0xffu);
-    }
+    uint8_t buf[sizeof(T)];
+    endian::storeLE<T>(buf, num);
+    write(buf, sizeof(T));
+  }
+
+  //! number of bytes written so far
+  size_t size() const noexcept {
+    return m_external == nullptr ? m_data.size() : m_size;
   }
 
-  const storage_t &data() const noexcept { return m_data; }
+  //! view of written bytes, valid in both owning and external modes
+  Slice<const uint8_t> slice() const noexcept {
+    return m_external == nullptr ? Slice<const uint8_t>(m_data)
+                                 : Slice<const uint8_t>(m_external, m_size);
+  }
+
+  //! written bytes; only available when stream owns its storage
+  const storage_t &data() const {
+    if (m_external != nullptr) {
+      throw std::logic_error(
+          "stream.data(): stream writes to external buffer, use slice()");
+    }
+    return m_data;
+  }
 
  private:
   storage_t m_data;
+  uint8_t *m_external = nullptr;
+  size_t m_capacity = 0;
+  size_t m_size = 0;
 };
 
 }  // namespace altintegration
@@ -0,0 +1,150 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <algorithm>
+#include <cstring>
+#include <veriblock/bytesearch.hpp>
+
+namespace altintegration {
+
+namespace {
+
+// Computes maximal suffix of `n` for the Two-Way algorithm, either w.r.t.
+// the normal (`reversed` = false) or the reversed byte order.
+// Returns position *before* the suffix start (may be SIZE_MAX, meaning -1),
+// writes its period into `period`.
+size_t maximalSuffix(const uint8_t* n, size_t l, bool reversed, size_t& period) {
+  size_t ip = static_cast<size_t>(-1);
+  size_t jp = 0;
+  size_t k = 1;
+  size_t p = 1;
+  while (jp + k < l) {
+    const uint8_t a = n[ip + k];
+    const uint8_t b = n[jp + k];
+    if (a == b) {
+      if (k == p) {
+        jp += p;
+        k = 1;
+      } else {
+        ++k;
+      }
+    } else if (reversed ? a < b : a > b) {
+      jp += k;
+      k = 1;
+      p = jp - ip;
+    } else {
+      ip = jp++;
+      k = p = 1;
+    }
+  }
+  period = p;
+  return ip;
+}
+
+size_t twoWaySearch(const uint8_t* h, size_t hl, const uint8_t* n, size_t l) {
+  // bad character shift: for every byte present in the needle, position of
+  // its last occurrence + 1. Bytes not in the needle skip the whole needle.
+  size_t shift[256];
+  std::fill(shift, shift + 256, 0);
+  for (size_t i = 0; i < l; ++i) {
+    shift[n[i]] = i + 1;
+  }
+
+  // critical factorization
+  size_t p0 = 0;
+  size_t p = 0;
+  size_t ms = maximalSuffix(n, l, false, p0);
+  size_t ms2 = maximalSuffix(n, l, true, p);
+  if (ms2 + 1 > ms + 1) {
+    ms = ms2;
+  } else {
+    p = p0;
+  }
+
+  // `mem` is the length of the needle prefix known to match, only used when
+  // the needle is periodic
+  size_t mem0 = 0;
+  if (std::memcmp(n, n + p, ms + 1) != 0) {
+    p = (std::max)(ms, l - ms - 1) + 1;
+  } else {
+    mem0 = l - p;
+  }
+  size_t mem = 0;
+
+  size_t pos = 0;
+  while (hl - pos >= l) {
+    const uint8_t* w = h + pos;
+
+    // check last byte first, skip by the bad character shift on mismatch
+    size_t s = shift[w[l - 1]];
+    if (s == 0) {
+      pos += l;
+      mem = 0;
+      continue;
+    }
+    if (s != l) {
+      pos += (std::max)(l - s, mem);
+      mem = 0;
+      continue;
+    }
+
+    // compare right half
+    size_t k = (std::max)(ms + 1, mem);
+    while (k < l && n[k] == w[k]) {
+      ++k;
+    }
+    if (k < l) {
+      pos += k - ms;
+      mem = 0;
+      continue;
+    }
+
+    // compare left half
+    k = ms + 1;
+    while (k > mem && n[k - 1] == w[k - 1]) {
+      --k;
+    }
+    if (k <= mem) {
+      return pos;
+    }
+    pos += p;
+    mem = mem0;
+  }
+
+  return hl;
+}
+
+}  // namespace
+
+size_t findBytes(Slice<const uint8_t> haystack,
+                 Slice<const uint8_t> needle,
+                 size_t from) {
+  const size_t size = haystack.size();
+  if (from > size || needle.size() > size - from) {
+    return size;
+  }
+  if (needle.size() == 0) {
+    return from;
+  }
+
+  const uint8_t* h = haystack.data() + from;
+  const size_t hl = size - from;
+  if (needle.size() == 1) {
+    auto* found = static_cast<const uint8_t*>(std::memchr(h, needle[0], hl));
+    return found == nullptr ? size : from + (found - h);
+  }
+
+  // skip to the first candidate using memchr, which is vectorized by libc
+  auto* first = static_cast<const uint8_t*>(std::memchr(h, needle[0], hl));
+  if (first == nullptr) {
+    return size;
+  }
+  const size_t skipped = first - h;
+  size_t pos =
+      twoWaySearch(first, hl - skipped, needle.data(), needle.size());
+  return pos == hl - skipped ? size : from + skipped + pos;
+}
+
+}  // namespace altintegration
@@ -46,10 +46,13 @@ static std::string getChecksumPortionFromAddress(const std::string& address,
   return address.substr(MULTISIG_ADDRESS_DATA_END + 1);
 }
 
-static bool isBase58String(const std::string& input) {
+static bool isBase58String(const std::string& input,
+                           size_t* decodedSize = nullptr) {
   try {
     auto decoded = DecodeBase58(input);
-    (void)decoded;
+    if (decodedSize != nullptr) {
+      *decodedSize = decoded.size();
+    }
     return true;
   } catch (const std::invalid_argument& /*ignore*/) {
     // do not throw - return status instead
@@ -57,10 +60,13 @@ static bool isBase58String(const std::string& input) {
   return false;
 }
 
-static bool isBase59String(const std::string& input) {
+static bool isBase59String(const std::string& input,
+                           size_t* decodedSize = nullptr) {
   try {
     auto decoded = DecodeBase59(input);
-    (void)decoded;
+    if (decodedSize != nullptr) {
+      *decodedSize = decoded.size();
+    }
     return true;
   } catch (const std::invalid_argument& /*ignore*/) {
     // do not throw - return status instead
@@ -146,11 +152,27 @@ void Address::toVbkEncoding(WriteStream& stream) const {
   writeSingleByteLenValue(stream, decoded);
 }
 
+size_t Address::estimateSize() const {
+  switch (getType()) {
+    case AddressType::STANDARD:
+    case AddressType::MULTISIG:
+      return 1 + singleByteLenValueSize(m_DecodedSize);
+    default:
+      return 1;
+  }
+}
+
 void Address::getPopBytes(WriteStream& stream) const {
   std::vector<uint8_t> bytes = DecodeBase58(m_Address.substr(1));
   stream.write(std::vector<uint8_t>(bytes.begin(), bytes.begin() + 16));
 }
 
+Address::Address(AddressType type, std::string addr)
+    : m_Type(type), m_Address(std::move(addr)) {
+  VBK_ASSERT(m_Type == AddressType::STANDARD);
+  m_DecodedSize = DecodeBase58(m_Address).size();
+}
+
 Address::Address(const std::string& input) {
   if (input.size() != ADDRESS_SIZE) {
     throw std::invalid_argument("isValidAddress(): invalid address length");
@@ -164,7 +186,7 @@ Address::Address(const std::string& input) {
   std::string checksum = getChecksumPortionFromAddress(input, multisig);
 
   if (multisig) {
-    if (!isBase59String(input)) {
+    if (!isBase59String(input, &m_DecodedSize)) {
       throw std::invalid_argument("isValidAddress(): not a base59 string");
     }
 
@@ -198,7 +220,7 @@ Address::Address(const std::string& input) {
           "isValidAddress(): remainder is not a base58 string");
     }
   } else {
-    if (!isBase58String(input)) {
+    if (!isBase58String(input, &m_DecodedSize)) {
       throw std::invalid_argument(
           "isValidAddress(): address is not a base58 string");
     }
@@ -42,8 +42,13 @@ void ATV::toVbkEncoding(WriteStream& stream) const {
   }
 }
 
+size_t ATV::estimateSize() const {
+  return sizeof(version) + transaction.estimateSize() +
+         merklePath.estimateSize() + blockOfProof.estimateSize();
+}
+
 std::vector<uint8_t> ATV::toVbkEncoding() const {
-  WriteStream stream;
+  WriteStream stream(estimateSize());
   toVbkEncoding(stream);
   return stream.data();
 }
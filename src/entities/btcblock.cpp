@@ -17,8 +17,10 @@ BtcBlock BtcBlock::fromRaw(const std::vector<uint8_t>& bytes) {
 BtcBlock BtcBlock::fromRaw(ReadStream& stream) {
   BtcBlock block{};
   block.version = stream.readLE<uint32_t>();
-  block.previousBlock = stream.readSlice(SHA256_HASH_SIZE).reverse();
-  block.merkleRoot = stream.readSlice(SHA256_HASH_SIZE).reverse();
+  stream.read(block.previousBlock);
+  std::reverse(block.previousBlock.begin(), block.previousBlock.end());
+  stream.read(block.merkleRoot);
+  std::reverse(block.merkleRoot.begin(), block.merkleRoot.end());
   block.timestamp = stream.readLE<uint32_t>();
   block.bits = stream.readLE<uint32_t>();
   block.nonce = stream.readLE<uint32_t>();
@@ -41,9 +43,14 @@ void BtcBlock::toRaw(WriteStream& stream) const {
 }
 
 void BtcBlock::toVbkEncoding(WriteStream& stream) const {
-  WriteStream blockStream;
-  toRaw(blockStream);
-  writeSingleByteLenValue(stream, blockStream.data());
+  stream.writeBE<uint8_t>((uint8_t)BTC_HEADER_SIZE);
+  toRaw(stream);
+}
+
+size_t BtcBlock::estimateRawSize() const { return BTC_HEADER_SIZE; }
+
+size_t BtcBlock::estimateSize() const {
+  return singleByteLenValueSize(estimateRawSize());
 }
 
 uint32_t BtcBlock::getDifficulty() const { return bits; }
@@ -51,7 +58,7 @@ uint32_t BtcBlock::getDifficulty() const { return bits; }
 uint32_t BtcBlock::getBlockTime() const { return timestamp; }
 
 uint256 BtcBlock::getHash() const {
-  WriteStream stream;
+  WriteStream stream(BTC_HEADER_SIZE);
   toRaw(stream);
   return sha256twice(stream.data()).reverse();
 }
@@ -64,7 +71,7 @@ BtcBlock BtcBlock::fromHex(const std::string& hex) {
 std::string BtcBlock::toHex() const { return HexStr(this->toRaw()); }
 
 std::vector<uint8_t> BtcBlock::toRaw() const {
-  WriteStream stream;
+  WriteStream stream(BTC_HEADER_SIZE);
   this->toRaw(stream);
   return stream.data();
 }
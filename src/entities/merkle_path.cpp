@@ -55,9 +55,20 @@ void MerklePath::toRaw(WriteStream& stream) const {
 }
 
 void MerklePath::toVbkEncoding(WriteStream& stream) const {
-  WriteStream pathStream;
-  toRaw(pathStream);
-  writeVarLenValue(stream, pathStream.data());
+  writeSingleBEValue(stream, estimateRawSize());
+  toRaw(stream);
+}
+
+size_t MerklePath::estimateRawSize() const {
+  size_t size = 3 * singleFixedBEValueSize<int32_t>() + sizeof(int32_t);
+  for (const auto& layer : layers) {
+    size += singleByteLenValueSize(layer.size());
+  }
+  return size;
+}
+
+size_t MerklePath::estimateSize() const {
+  return varLenValueSize(estimateRawSize());
 }
 
 uint256 MerklePath::calculateMerkleRoot() const {
@@ -63,8 +63,25 @@ void PopData::toVbkEncoding(WriteStream& stream) const {
   }
 }
 
+size_t PopData::estimateSize() const {
+  size_t size = sizeof(version);
+  size += singleBEValueSize(context.size());
+  for (const auto& b : context) {
+    size += b.estimateSize();
+  }
+  size += singleBEValueSize(atvs.size());
+  for (const auto& atv : atvs) {
+    size += atv.estimateSize();
+  }
+  size += singleBEValueSize(vtbs.size());
+  for (const auto& vtb : vtbs) {
+    size += vtb.estimateSize();
+  }
+  return size;
+}
+
 std::vector<uint8_t> PopData::toVbkEncoding() const {
-  WriteStream stream;
+  WriteStream stream(estimateSize());
   toVbkEncoding(stream);
   return stream.data();
 }
@@ -0,0 +1,307 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include "veriblock/entities/popdata_view.hpp"
+
+#include "veriblock/assert.hpp"
+#include "veriblock/checks.hpp"
+#include "veriblock/hashutil.hpp"
+
+namespace altintegration {
+
+namespace {
+
+// bytes consumed by `stream` since position `start`
+Slice<const uint8_t> consumedSince(const ReadStream& stream, size_t start) {
+  return Slice<const uint8_t>(stream.data().data() + start,
+                              stream.position() - start);
+}
+
+// raw tx must be consumed completely, otherwise its hash does not match the
+// hash of decoded tx
+void checkConsumed(const ReadStream& stream, const std::string& name) {
+  if (stream.remaining() != 0) {
+    throw std::invalid_argument(fmt::format(
+        "{} has {} unexpected trailing bytes", name, stream.remaining()));
+  }
+}
+
+// same checks as Address::fromVbkEncoding, but address is not encoded
+void skipAddress(ReadStream& stream) {
+  auto addressType = (AddressType)stream.readLE<uint8_t>();
+  if (addressType != AddressType::STANDARD &&
+      addressType != AddressType::MULTISIG) {
+    throw std::invalid_argument(
+        "addressFromVbkEncoding(): invalid address type: neither standard, "
+        "nor multisig");
+  }
+  readSingleByteLenValue(stream, 0, ADDRESS_SIZE);
+}
+
+// same checks as VbkTx::fromRaw, but nothing is decoded
+void checkVbkTx(Slice<const uint8_t> rawTx) {
+  ReadStream stream(rawTx);
+  readNetworkByte(stream, TxType::VBK_TX);
+  skipAddress(stream);
+  readSingleBEValue<int64_t>(stream);
+
+  uint8_t outputSize = stream.readBE<uint8_t>();
+  for (size_t i = 0; i < outputSize; i++) {
+    skipAddress(stream);
+    readSingleBEValue<int64_t>(stream);
+  }
+
+  readSingleBEValue<int64_t>(stream);
+  ReadStream pub(readVarLenValue(stream, 0, MAX_SIZE_PUBLICATION_DATA));
+  readSingleBEValue<int64_t>(pub);
+  readVarLenValue(pub, 0, MAX_HEADER_SIZE_PUBLICATION_DATA);
+  readVarLenValue(pub, 0, MAX_CONTEXT_SIZE_PUBLICATION_DATA);
+  readVarLenValue(pub, 0, MAX_PAYOUT_SIZE_PUBLICATION_DATA);
+  checkConsumed(stream, "VbkTx");
+}
+
+// same checks as MerklePath::fromVbkEncoding, but nothing is decoded
+void skipMerklePath(ReadStream& stream) {
+  ReadStream path(readVarLenValue(stream, 0, MAX_MERKLE_BYTES));
+  readSingleBEValue<int32_t>(path);
+  const auto numLayers = readSingleBEValue<int32_t>(path);
+  checkRange(numLayers, 0, MAX_LAYER_COUNT_MERKLE);
+  if (readSingleBEValue<int32_t>(path) != sizeof(int32_t)) {
+    throw std::invalid_argument(
+        "MerklePath.fromRaw(): bad sizeOfSizeBottomData");
+  }
+  if (path.readBE<int32_t>() != SHA256_HASH_SIZE) {
+    throw std::invalid_argument(
+        "MerklePath.fromRaw(): bad size of bottom data");
+  }
+  for (int32_t i = 0; i < numLayers; i++) {
+    readSingleByteLenValue(path, SHA256_HASH_SIZE, SHA256_HASH_SIZE);
+  }
+}
+
+}  // namespace
+
+uint256 VbkMerklePathView::layer(size_t i) const {
+  VBK_ASSERT(i < layersCount_);
+  return Slice<const uint8_t>(
+      layers_.data() + i * (SHA256_HASH_SIZE + 1) + 1, SHA256_HASH_SIZE);
+}
+
+uint128 VbkMerklePathView::calculateMerkleRoot() const {
+  if (layersCount_ == 0) {
+    return subject.trim<VBK_MERKLE_ROOT_HASH_SIZE>();
+  }
+
+  uint256 cursor = subject;
+  auto layerIndex = index;
+  for (size_t i = 0, size = layersCount_; i < size; ++i) {
+    if (i == size - 1) {
+      // metapackage hash is on the left
+      layerIndex = 1;
+    } else if (i == size - 2) {
+      layerIndex = treeIndex;
+    }
+
+    auto l = layer(i);
+    auto& left = layerIndex & 1u ? l : cursor;
+    auto& right = layerIndex & 1u ? cursor : l;
+    cursor = sha256(left, right);
+    layerIndex >>= 1u;
+  }
+
+  return cursor.trim<VBK_MERKLE_ROOT_HASH_SIZE>();
+}
+
+VbkMerklePath VbkMerklePathView::toVbkMerklePath() const {
+  VbkMerklePath path{};
+  path.treeIndex = treeIndex;
+  path.index = index;
+  path.subject = subject;
+  path.layers.reserve(layersCount_);
+  for (size_t i = 0; i < layersCount_; ++i) {
+    path.layers.push_back(layer(i));
+  }
+  return path;
+}
+
+VbkMerklePathView VbkMerklePathView::fromVbkEncoding(ReadStream& stream) {
+  VbkMerklePathView path{};
+  path.treeIndex = readSingleBEValue<int32_t>(stream);
+  path.index = readSingleBEValue<int32_t>(stream);
+  path.subject =
+      readSingleByteLenValue(stream, SHA256_HASH_SIZE, SHA256_HASH_SIZE);
+
+  const auto count = readSingleBEValue<int32_t>(stream);
+  checkRange(count, 0, MAX_LAYER_COUNT_MERKLE);
+  const size_t start = stream.position();
+  for (int32_t i = 0; i < count; ++i) {
+    readSingleByteLenValue(stream, SHA256_HASH_SIZE, SHA256_HASH_SIZE);
+  }
+  path.layers_ = consumedSince(stream, start);
+  path.layersCount_ = (size_t)count;
+  return path;
+}
+
+VbkBlock ATVView::blockOfProof() const {
+  return VbkBlock::fromRaw(blockOfProof_);
+}
+
+uint256 ATVView::getTransactionHash() const { return sha256(rawTx_); }
+
+ATV::id_t ATVView::getId() const {
+  auto left = getTransactionHash();
+  auto right = vblake(blockOfProof_);
+  return sha256(left, right);
+}
+
+ATV ATVView::toATV() const { return ATV::fromVbkEncoding(data_); }
+
+ATVView ATVView::fromVbkEncoding(ReadStream& stream) {
+  ATVView atv{};
+  const size_t start = stream.position();
+  atv.version = stream.readBE<uint32_t>();
+  if (atv.version != 1) {
+    throw std::domain_error(fmt::format(
+        "ATV deserialization version={} is not implemented", atv.version));
+  }
+
+  atv.rawTx_ = readVarLenValue(stream, 0, MAX_RAWTX_SIZE_VBKTX);
+  checkVbkTx(atv.rawTx_);
+  atv.signature_ = readSingleByteLenValue(stream, 0, MAX_SIGNATURE_SIZE);
+  atv.publicKey_ = readSingleByteLenValue(stream, 0, PUBLIC_KEY_SIZE);
+  atv.merklePath_ = VbkMerklePathView::fromVbkEncoding(stream);
+  atv.blockOfProof_ =
+      readSingleByteLenValue(stream, VBK_HEADER_SIZE, VBK_HEADER_SIZE);
+  atv.data_ = consumedSince(stream, start);
+  return atv;
+}
+
+ATVView ATVView::fromVbkEncoding(Slice<const uint8_t> bytes) {
+  ReadStream stream(bytes);
+  return fromVbkEncoding(stream);
+}
+
+VbkBlock VTBView::publishedBlock() const {
+  return VbkBlock::fromRaw(publishedBlock_);
+}
+
+BtcBlock VTBView::blockOfProof() const {
+  ReadStream stream(blockOfProof_);
+  return BtcBlock::fromRaw(stream);
+}
+
+VbkBlock VTBView::containingBlock() const {
+  return VbkBlock::fromRaw(containingBlock_);
+}
+
+uint256 VTBView::getTransactionHash() const { return sha256(rawTx_); }
+
+VTB::id_t VTBView::getStronglyEquivalencyId() const {
+  auto btcTx = sha256twice(btcTx_);
+  auto blockOfProof = sha256twice(blockOfProof_).reverse();
+  return sha256(btcTx, blockOfProof);
+}
+
+VTB::id_t VTBView::getId() const {
+  auto btcTx = sha256twice(btcTx_);
+  auto blockOfProof = sha256twice(blockOfProof_).reverse();
+  auto containingVbkBlock = uint256(vblake(containingBlock_));
+  auto temp = sha256(blockOfProof, containingVbkBlock);
+  return sha256(btcTx, temp);
+}
+
+VTB VTBView::toVTB() const { return VTB::fromVbkEncoding(data_); }
+
+VTBView VTBView::fromVbkEncoding(ReadStream& stream) {
+  VTBView vtb{};
+  const size_t start = stream.position();
+  vtb.version = stream.readBE<uint32_t>();
+  if (vtb.version != 1) {
+    throw std::domain_error(
+        fmt::format("VTB version={} is not implemented", vtb.version));
+  }
+
+  vtb.rawTx_ = readVarLenValue(stream, 0, MAX_RAWTX_SIZE_VBKPOPTX);
+  vtb.signature_ = readSingleByteLenValue(stream, 0, MAX_SIGNATURE_SIZE);
+  vtb.publicKey_ = readSingleByteLenValue(stream, 0, PUBLIC_KEY_SIZE);
+  vtb.merklePath_ = VbkMerklePathView::fromVbkEncoding(stream);
+  vtb.containingBlock_ =
+      readSingleByteLenValue(stream, VBK_HEADER_SIZE, VBK_HEADER_SIZE);
+  vtb.data_ = consumedSince(stream, start);
+
+  // same checks as VbkPopTx::fromRaw. Fields, which are needed to calculate
+  // VTB id, are located, address, BTC merkle path and context are skipped.
+  ReadStream tx(vtb.rawTx_);
+  readNetworkByte(tx, TxType::VBK_POP_TX);
+  skipAddress(tx);
+  vtb.publishedBlock_ =
+      readSingleByteLenValue(tx, VBK_HEADER_SIZE, VBK_HEADER_SIZE);
+  vtb.btcTx_ = readVarLenValue(tx, 0, BTC_TX_MAX_RAW_SIZE);
+  skipMerklePath(tx);
+  vtb.blockOfProof_ =
+      readSingleByteLenValue(tx, BTC_HEADER_SIZE, BTC_HEADER_SIZE);
+  const auto contextSize = readSingleBEValue<int32_t>(tx);
+  checkRange(contextSize, 0, MAX_CONTEXT_COUNT);
+  for (int32_t i = 0; i < contextSize; i++) {
+    readSingleByteLenValue(tx, BTC_HEADER_SIZE, BTC_HEADER_SIZE);
+  }
+  checkConsumed(tx, "VbkPopTx");
+  return vtb;
+}
+
+VTBView VTBView::fromVbkEncoding(Slice<const uint8_t> bytes) {
+  ReadStream stream(bytes);
+  return fromVbkEncoding(stream);
+}
+
+PopData PopDataView::toPopData() const {
+  PopData pd;
+  pd.version = version;
+  pd.context = context;
+  pd.vtbs.reserve(vtbs.size());
+  for (const auto& vtb : vtbs) {
+    pd.vtbs.push_back(vtb.toVTB());
+  }
+  pd.atvs.reserve(atvs.size());
+  for (const auto& atv : atvs) {
+    pd.atvs.push_back(atv.toATV());
+  }
+  return pd;
+}
+
+PopDataView PopDataView::fromVbkEncoding(ReadStream& stream) {
+  PopDataView pd;
+  pd.version = stream.readBE<uint32_t>();
+  if (pd.version == 1) {
+    pd.context = readArrayOf<VbkBlock>(
+        stream,
+        0,
+        MAX_CONTEXT_COUNT,
+        (VbkBlock(*)(ReadStream&))VbkBlock::fromVbkEncoding);
+
+    pd.atvs = readArrayOf<ATVView>(
+        stream,
+        0,
+        MAX_CONTEXT_COUNT_ALT_PUBLICATION,
+        (ATVView(*)(ReadStream&))ATVView::fromVbkEncoding);
+
+    pd.vtbs = readArrayOf<VTBView>(
+        stream,
+        0,
+        MAX_CONTEXT_COUNT_VBK_PUBLICATION,
+        (VTBView(*)(ReadStream&))VTBView::fromVbkEncoding);
+  } else {
+    throw std::domain_error(fmt::format(
+        "PopData deserialization version={} is not implemented", pd.version));
+  }
+  return pd;
+}
+
+PopDataView PopDataView::fromVbkEncoding(Slice<const uint8_t> bytes) {
+  ReadStream stream(bytes);
+  return fromVbkEncoding(stream);
+}
+
+}  // namespace altintegration
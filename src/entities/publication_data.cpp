@@ -30,3 +30,9 @@ void PublicationData::toRaw(WriteStream& stream) const {
   writeVarLenValue(stream, contextInfo);
   writeVarLenValue(stream, payoutInfo);
 }
+
+size_t PublicationData::estimateRawSize() const {
+  return singleBEValueSize(identifier) + varLenValueSize(header.size()) +
+         varLenValueSize(contextInfo.size()) +
+         varLenValueSize(payoutInfo.size());
+}
@@ -18,11 +18,10 @@ VbkBlock VbkBlock::fromRaw(ReadStream& stream) {
   VbkBlock block{};
   block.height = stream.readBE<int32_t>();
   block.version = stream.readBE<int16_t>();
-  block.previousBlock = stream.readSlice(VBLAKE_PREVIOUS_BLOCK_HASH_SIZE);
-  block.previousKeystone = stream.readSlice(VBLAKE_PREVIOUS_KEYSTONE_HASH_SIZE);
-  block.secondPreviousKeystone =
-      stream.readSlice(VBLAKE_PREVIOUS_KEYSTONE_HASH_SIZE);
-  block.merkleRoot = stream.readSlice(VBK_MERKLE_ROOT_HASH_SIZE);
+  stream.read(block.previousBlock);
+  stream.read(block.previousKeystone);
+  stream.read(block.secondPreviousKeystone);
+  stream.read(block.merkleRoot);
   block.timestamp = stream.readBE<int32_t>();
   block.difficulty = stream.readBE<int32_t>();
   block.nonce = stream.readBE<int32_t>();
@@ -42,13 +41,18 @@ VbkBlock VbkBlock::fromVbkEncoding(const std::string& bytes) {
 }
 
 void VbkBlock::toVbkEncoding(WriteStream& stream) const {
-  WriteStream blockStream;
-  toRaw(blockStream);
-  writeSingleByteLenValue(stream, blockStream.data());
+  stream.writeBE<uint8_t>((uint8_t)VBK_HEADER_SIZE);
+  toRaw(stream);
+}
+
+size_t VbkBlock::estimateRawSize() const { return VBK_HEADER_SIZE; }
+
+size_t VbkBlock::estimateSize() const {
+  return singleByteLenValueSize(estimateRawSize());
 }
 
 std::vector<uint8_t> VbkBlock::toVbkEncoding() const {
-  WriteStream stream;
+  WriteStream stream(estimateSize());
   toVbkEncoding(stream);
   return stream.data();
 }
@@ -58,7 +62,7 @@ uint32_t VbkBlock::getDifficulty() const { return difficulty; }
 uint32_t VbkBlock::getBlockTime() const { return timestamp; }
 
 VbkBlock::hash_t VbkBlock::getHash() const {
-  WriteStream stream;
+  WriteStream stream(VBK_HEADER_SIZE);
   toRaw(stream);
   return vblake(stream.data());
 }
@@ -87,7 +91,7 @@ void VbkBlock::toRaw(WriteStream& stream) const {
 }
 
 std::vector<uint8_t> VbkBlock::toRaw() const {
-  WriteStream stream;
+  WriteStream stream(VBK_HEADER_SIZE);
   toRaw(stream);
   return stream.data();
 }
@@ -51,15 +51,32 @@ void VbkPopTx::toRaw(WriteStream& stream) const {
 }
 
 void VbkPopTx::toVbkEncoding(WriteStream& stream) const {
-  WriteStream txStream;
-  toRaw(txStream);
-  writeVarLenValue(stream, txStream.data());
+  writeSingleBEValue(stream, estimateRawSize());
+  toRaw(stream);
   writeSingleByteLenValue(stream, signature);
   writeSingleByteLenValue(stream, publicKey);
 }
 
+size_t VbkPopTx::estimateRawSize() const {
+  size_t size = (networkOrType.hasNetworkByte ? 2 : 1) +
+                address.estimateSize() + publishedBlock.estimateSize() +
+                bitcoinTransaction.estimateSize() + merklePath.estimateSize() +
+                blockOfProof.estimateSize();
+  size += singleBEValueSize(blockOfProofContext.size());
+  for (const auto& block : blockOfProofContext) {
+    size += block.estimateSize();
+  }
+  return size;
+}
+
+size_t VbkPopTx::estimateSize() const {
+  return varLenValueSize(estimateRawSize()) +
+         singleByteLenValueSize(signature.size()) +
+         singleByteLenValueSize(publicKey.size());
+}
+
 uint256 VbkPopTx::getHash() const {
-  WriteStream stream;
+  WriteStream stream(estimateRawSize());
   toRaw(stream);
   return sha256(stream.data());
 }
@@ -50,21 +50,36 @@ void VbkTx::toRaw(WriteStream& stream) const {
   }
   writeSingleBEValue(stream, signatureIndex);
 
-  WriteStream pubBytesStream;
-  publicationData.toRaw(pubBytesStream);
-  writeVarLenValue(stream, pubBytesStream.data());
+  writeSingleBEValue(stream, publicationData.estimateRawSize());
+  publicationData.toRaw(stream);
 }
 
 void VbkTx::toVbkEncoding(WriteStream& stream) const {
-  WriteStream txStream;
-  toRaw(txStream);
-  writeVarLenValue(stream, txStream.data());
+  writeSingleBEValue(stream, estimateRawSize());
+  toRaw(stream);
   writeSingleByteLenValue(stream, signature);
   writeSingleByteLenValue(stream, publicKey);
 }
 
+size_t VbkTx::estimateRawSize() const {
+  size_t size = (networkOrType.hasNetworkByte ? 2 : 1) +
+                sourceAddress.estimateSize() + sourceAmount.estimateSize() + 1;
+  for (const auto& output : outputs) {
+    size += output.estimateSize();
+  }
+  size += singleBEValueSize(signatureIndex);
+  size += varLenValueSize(publicationData.estimateRawSize());
+  return size;
+}
+
+size_t VbkTx::estimateSize() const {
+  return varLenValueSize(estimateRawSize()) +
+         singleByteLenValueSize(signature.size()) +
+         singleByteLenValueSize(publicKey.size());
+}
+
 uint256 VbkTx::getHash() const {
-  WriteStream stream;
+  WriteStream stream(estimateRawSize());
   toRaw(stream);
   return sha256(stream.data());
 }
@@ -47,8 +47,13 @@ void VTB::toVbkEncoding(WriteStream& stream) const {
   }
 }
 
+size_t VTB::estimateSize() const {
+  return sizeof(version) + transaction.estimateSize() +
+         merklePath.estimateSize() + containingBlock.estimateSize();
+}
+
 std::vector<uint8_t> VTB::toVbkEncoding() const {
-  WriteStream stream;
+  WriteStream stream(estimateSize());
   toVbkEncoding(stream);
   return stream.data();
 }
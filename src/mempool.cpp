@@ -6,6 +6,7 @@
 #include <deque>
 #include <veriblock/reversed_range.hpp>
 
+#include "veriblock/assert.hpp"
 #include "veriblock/entities/vbkfullblock.hpp"
 #include "veriblock/mempool.hpp"
 #include "veriblock/stateless_validation.hpp"
@@ -14,65 +15,81 @@ namespace altintegration {
 
 namespace {
 
-template <typename pop_t>
-bool process_cut_payloads(std::vector<pop_t>& payloads, size_t& current_size) {
-  if (!payloads.empty()) {
-    auto& p = payloads.back();
-    current_size -= p.toVbkEncoding().size();
-    payloads.pop_back();
-    return true;
-  }
+// version and sizes of 3 arrays in serialized PopData
+constexpr size_t kPopDataOverhead =
+    sizeof(uint32_t) + 3 * (1 + sizeof(int32_t));
 
-  return false;
-}
+// serialized VbkBlock is [1 byte size | header]
+constexpr size_t kVbkBlockSize = 1 + VBK_HEADER_SIZE;
 
-size_t cutPopData(PopData& popData, size_t current_size) {
-  // first remove vtb
-  if (process_cut_payloads(popData.vtbs, current_size)) {
-    return current_size;
-  }
-  // second remove atv
-  if (process_cut_payloads(popData.atvs, current_size)) {
-    return current_size;
-  }
-  // third remove vbk blocks
-  if (process_cut_payloads(popData.context, current_size)) {
-    return current_size;
-  }
+// maximum number of orphan VBK blocks and VTBs
+constexpr size_t kMaxOrphans = 1000;
 
-  return current_size;
+// hash of BTC block, to which BTC context of `vtb` connects
+// @see VbkBlockTree::validateBTCContext
+uint256 connectingBtcHash(const VTB& vtb) {
+  auto& tx = vtb.transaction;
+  auto& first = tx.blockOfProofContext.empty() ? tx.blockOfProof
+                                               : tx.blockOfProofContext[0];
+  return first.previousBlock != uint256() ? first.previousBlock
+                                          : first.getHash();
 }
 
-PopData generatePopData(
-    const std::vector<
-        std::pair<VbkBlock::id_t,
-                  std::shared_ptr<MemPool::VbkPayloadsRelations>>>& blocks,
-    const AltChainParams& params) {
-  PopData ret;
-  // size in bytes of pop data added to
-  size_t popSize = 0;
-
-  for (const auto& block : blocks) {
-    PopData pop = block.second->toPopData();
-    size_t estimated = pop.estimateSize();
+// hashes of BTC blocks carried by `vtb`
+std::vector<uint256> btcBlocksOf(const VTB& vtb) {
+  std::vector<uint256> ret;
+  ret.reserve(vtb.transaction.blockOfProofContext.size() + 1);
+  for (const auto& b : vtb.transaction.blockOfProofContext) {
+    ret.push_back(b.getHash());
+  }
+  ret.push_back(vtb.transaction.blockOfProof.getHash());
+  return ret;
+}
 
-    while (popSize + estimated > params.getMaxPopDataSize() && !pop.empty()) {
-      estimated = cutPopData(pop, estimated);
+// returns false if pool of orphans is full
+template <typename Key, typename T>
+bool addOrphan(std::multimap<Key, T>& orphans,
+               const Key& parent,
+               const T& payload,
+               size_t total) {
+  auto range = orphans.equal_range(parent);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == payload) {
+      return true;
     }
+  }
 
-    if (popSize + estimated > params.getMaxPopDataSize() || pop.empty()) {
-      continue;
-    }
+  if (total >= kMaxOrphans) {
+    return false;
+  }
+  orphans.insert({parent, payload});
+  return true;
+}
 
-    popSize += estimated;
-    ret.mergeFrom(pop);
+// remove orphans with given parent and return them
+template <typename Key, typename T>
+std::vector<T> takeOrphans(std::multimap<Key, T>& orphans, const Key& parent) {
+  std::vector<T> ret;
+  auto range = orphans.equal_range(parent);
+  for (auto it = range.first; it != range.second; ++it) {
+    ret.push_back(it->second);
+  }
+  orphans.erase(range.first, range.second);
+  return ret;
+}
 
-    if (popSize > params.getMaxPopDataSize()) {
-      break;
+// first-fit selection of payloads into `out`, in order
+template <typename Payload>
+void selectPayloads(
+    const std::vector<MemPool::SizedPayload<Payload>>& payloads,
+    size_t& remaining,
+    std::vector<Payload>& out) {
+  for (const auto& p : payloads) {
+    if (p.size <= remaining) {
+      remaining -= p.size;
+      out.push_back(*p);
     }
   }
-
-  return ret;
 }
 
 }  // namespace
@@ -99,7 +116,7 @@ PopData MemPool::VbkPayloadsRelations::toPopData() const {
 
 void MemPool::VbkPayloadsRelations::removeVTB(const VTB::id_t& vtb_id) {
   auto it = std::find_if(
-      vtbs.begin(), vtbs.end(), [&vtb_id](const std::shared_ptr<VTB>& vtb) {
+      vtbs.begin(), vtbs.end(), [&vtb_id](const SizedPayload<VTB>& vtb) {
         return vtb->getId() == vtb_id;
       });
 
@@ -110,7 +127,7 @@ void MemPool::VbkPayloadsRelations::removeVTB(const VTB::id_t& vtb_id) {
 
 void MemPool::VbkPayloadsRelations::removeATV(const ATV::id_t& atv_id) {
   auto it = std::find_if(
-      atvs.begin(), atvs.end(), [&atv_id](const std::shared_ptr<ATV>& atv) {
+      atvs.begin(), atvs.end(), [&atv_id](const SizedPayload<ATV>& atv) {
         return atv->getId() == atv_id;
       });
 
@@ -120,115 +137,528 @@ void MemPool::VbkPayloadsRelations::removeATV(const ATV::id_t& atv_id) {
 }
 
 PopData MemPool::getPop() {
-  // sorted array of VBK blocks (ascending order)
-  using P = std::pair<VbkBlock::id_t, std::shared_ptr<VbkPayloadsRelations>>;
-  std::vector<P> blocks(relations_.begin(), relations_.end());
-  std::sort(blocks.begin(), blocks.end(), [](const P& a, const P& b) {
-    return a.second->header->height < b.second->header->height;
-  });
+  std::lock_guard<std::mutex> lock(mutex_);
+  PopData ret;
+  size_t maxSize = tree_->getParams().getMaxPopDataSize();
+  size_t remaining =
+      maxSize > kPopDataOverhead ? maxSize - kPopDataOverhead : 0;
+
+  for (const auto& key : relations_by_height_) {
+    const auto& rel = *relations_.at(key.second);
+    // payloads can not be added without their VBK block
+    if (kVbkBlockSize > remaining) {
+      continue;
+    }
+    remaining -= kVbkBlockSize;
+    ret.context.push_back(*rel.header);
+
+    selectPayloads(rel.atvs, remaining, ret.atvs);
+    selectPayloads(rel.vtbs, remaining, ret.vtbs);
+  }
 
-  PopData ret = generatePopData(blocks, tree_->getParams());
   tree_->filterInvalidPayloads(ret);
   return ret;
 }
 
-void MemPool::vacuum(const PopData& pop) {
-  auto vbkblockids = make_idset(pop.context);
-  auto vtb_strong_ids = make_idset<VTB>(pop.vtbs, get_strong_id<VTB>);
-  auto atv_strong_ids = make_idset<ATV>(pop.atvs, get_strong_id<ATV>);
-
+MemPool::relations_map_t::iterator MemPool::removeRelation(
+    relations_map_t::iterator it) {
   // cascade removal of relation and stored payloads
-  auto removeRelation = [&](decltype(relations_.begin()) it) {
-    auto& rel = *it->second;
-    vbkblocks_.erase(it->first);
-    for (auto& vtb : rel.vtbs) {
-      stored_vtbs_.erase(vtb->getStronglyEquivalencyId());
-    }
-    for (auto& atv : rel.atvs) {
-      stored_atvs_.erase(atv->getStronglyEquivalencyId());
+  auto& rel = *it->second;
+  relations_by_height_.erase({rel.header->height, it->first});
+  vbkblocks_.erase(it->first);
+  vbkblocks_changed_ = true;
+  by_priority_.erase({rel.header->height,
+                      kVbkBlockSize,
+                      PriorityKey::Kind::VBK_BLOCK,
+                      it->first,
+                      uint256()});
+  stats_.bytes -= kVbkBlockSize;
+  for (auto& vtb : rel.vtbs) {
+    forget(*it, vtb);
+  }
+  for (auto& atv : rel.atvs) {
+    forget(*it, atv);
+  }
+  return relations_.erase(it);
+}
+
+MemPool::relations_map_t::iterator MemPool::cleanupRelation(
+    relations_map_t::iterator it, const VacuumContext& ctx) {
+  auto& rel = *it->second;
+  auto* index = tree_->vbk().getBlockIndex(rel.header->getHash());
+
+  // cleanup stale VTBs
+  for (auto vtbit = rel.vtbs.begin(); vtbit != rel.vtbs.end();) {
+    auto& vtb = **vtbit;
+    ValidationState state;
+    auto strong_id = vtb.getStronglyEquivalencyId();
+    if (ctx.vtb_strong_ids.count(strong_id) > 0 ||
+        !checkContextually(vtb, state)) {
+      forget(*it, *vtbit);
+      vtbit = rel.vtbs.erase(vtbit);
+    } else {
+      ++vtbit;
     }
-    return relations_.erase(it);
-  };
+  }
 
-  for (auto it = relations_.begin(); it != relations_.end();) {
-    auto blockHash = it->second->header->getHash();
-    auto& vbk = tree_->vbk();
-    auto* index = vbk.getBlockIndex(blockHash);
-    auto* tip = vbk.getBestChain().tip();
-    auto maxReorgBlocks = vbk.getParams().getMaxReorgBlocks();
-    auto& rel = *it->second;
-
-    bool tooOld = tip->getHeight() - maxReorgBlocks > rel.header->height;
-    if (tooOld) {
-      // VBK block is too old to be included or modified
-      it = removeRelation(it);
-      continue;
+  // cleanup stale ATVs
+  for (auto atvit = rel.atvs.begin(); atvit != rel.atvs.end();) {
+    auto& atv = **atvit;
+    auto strong_id = atv.getStronglyEquivalencyId();
+    ValidationState state;
+    if (ctx.atv_strong_ids.count(strong_id) > 0 ||
+        !checkContextually(atv, state)) {
+      forget(*it, *atvit);
+      atvit = rel.atvs.erase(atvit);
+    } else {
+      ++atvit;
     }
+  }
+
+  if (index != nullptr) {
+    // VBK tree knows about this VBK block
+    // does it know about stored VTBs?
+    auto& v = index->getPayloadIds<VTB>();
+    std::set<VTB::id_t> ids(v.begin(), v.end());
+    // include vtbs that have just been included into new block
+    ids.insert(ctx.vtb_ids.begin(), ctx.vtb_ids.end());
 
-    // cleanup stale VTBs
     for (auto vtbit = rel.vtbs.begin(); vtbit != rel.vtbs.end();) {
       auto& vtb = **vtbit;
-      ValidationState state;
-      auto strong_id = vtb.getStronglyEquivalencyId();
-      if (vtb_strong_ids.count(strong_id) > 0 ||
-          !checkContextually(vtb, state)) {
-        stored_vtbs_.erase(strong_id);
+      // mempool contains VBK block, which already exists in VBK tree, and
+      // we found a VTB which exists in that VBK block. we can remove VTB
+      // from mempool
+      if (ids.count(vtb.getId())) {
+        forget(*it, *vtbit);
         vtbit = rel.vtbs.erase(vtbit);
       } else {
         ++vtbit;
       }
     }
 
-    // cleanup stale ATVs
-    for (auto atvit = rel.atvs.begin(); atvit != rel.atvs.end();) {
-      auto& atv = **atvit;
-      auto strong_id = atv.getStronglyEquivalencyId();
-      ValidationState state;
-      if (atv_strong_ids.count(strong_id) > 0 ||
-          !checkContextually(atv, state)) {
-        stored_atvs_.erase(strong_id);
-        atvit = rel.atvs.erase(atvit);
-      } else {
-        ++atvit;
-      }
+    if (rel.empty()) {
+      return removeRelation(it);
     }
+  }
+
+  // if header is recently added to new block or relation is empty, cleanup
+  if (ctx.vbkblock_ids.count(rel.header->getId()) && rel.empty()) {
+    return removeRelation(it);
+  }
 
-    if (index != nullptr) {
-      // VBK tree knows about this VBK block
-      // does it know about stored VTBs?
-      auto& v = index->getPayloadIds<VTB>();
-      std::set<VTB::id_t> ids(v.begin(), v.end());
-      // include vtbs that have just been included into new block
-      std::transform(pop.vtbs.begin(),
-                     pop.vtbs.end(),
-                     std::inserter(ids, std::end(ids)),
-                     get_id<VTB>);
-
-      for (auto vtbit = rel.vtbs.begin(); vtbit != rel.vtbs.end();) {
-        auto id = (*vtbit)->getId();
-        // mempool contains VBK block, which already exists in VBK tree, and
-        // we found a VTB which exists in that VBK block. we can remove VTB
-        // from mempool
-        vtbit = ids.count(id) ? rel.vtbs.erase(vtbit) : std::next(vtbit);
+  return std::next(it);
+}
+
+void MemPool::remember(const VbkBlock::id_t& rel_id,
+                       const SizedPayload<VTB>& vtb) {
+  auto& rel = *relations_.at(rel_id);
+  auto strong_id = vtb->getStronglyEquivalencyId();
+  rel.vtbs.push_back(vtb);
+  vtbs_changed_ |= stored_vtbs_.insert({strong_id, vtb.payload}).second;
+  vtb_relations_.insert({strong_id, rel_id});
+  by_priority_.insert({rel.header->height,
+                       vtb.size,
+                       PriorityKey::Kind::VTB,
+                       rel_id,
+                       vtb->getId()});
+  stats_.bytes += vtb.size;
+
+  for (const auto& hash : btcBlocksOf(*vtb)) {
+    ++btc_provided_[hash];
+    if (!orphan_vtbs_.empty()) {
+      new_btc_parents_.push_back(hash);
+    }
+  }
+}
+
+void MemPool::remember(const VbkBlock::id_t& rel_id,
+                       const SizedPayload<ATV>& atv) {
+  auto& rel = *relations_.at(rel_id);
+  rel.atvs.push_back(atv);
+  atvs_changed_ |=
+      stored_atvs_.insert({atv->getStronglyEquivalencyId(), atv.payload})
+          .second;
+  by_priority_.insert({rel.header->height,
+                       atv.size,
+                       PriorityKey::Kind::ATV,
+                       rel_id,
+                       atv->getId()});
+  stats_.bytes += atv.size;
+}
+
+void MemPool::forget(const relations_map_t::value_type& rel,
+                     const SizedPayload<VTB>& vtb) {
+  PriorityKey key{rel.second->header->height,
+                  vtb.size,
+                  PriorityKey::Kind::VTB,
+                  rel.first,
+                  vtb->getId()};
+  if (by_priority_.erase(key) > 0) {
+    stats_.bytes -= vtb.size;
+    for (const auto& hash : btcBlocksOf(*vtb)) {
+      auto it = btc_provided_.find(hash);
+      VBK_ASSERT(it != btc_provided_.end());
+      if (--it->second == 0) {
+        btc_provided_.erase(it);
       }
+    }
+  }
+
+  // VTBs with equal strong ids may be stored in different relations
+  auto strong_id = vtb->getStronglyEquivalencyId();
+  auto stored = stored_vtbs_.find(strong_id);
+  if (stored != stored_vtbs_.end() && stored->second == vtb.payload) {
+    stored_vtbs_.erase(stored);
+    vtbs_changed_ = true;
+  }
+  auto range = vtb_relations_.equal_range(strong_id);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == rel.first) {
+      vtb_relations_.erase(it);
+      break;
+    }
+  }
+}
 
-      if (rel.empty()) {
-        it = removeRelation(it);
+void MemPool::forget(const relations_map_t::value_type& rel,
+                     const SizedPayload<ATV>& atv) {
+  PriorityKey key{rel.second->header->height,
+                  atv.size,
+                  PriorityKey::Kind::ATV,
+                  rel.first,
+                  atv->getId()};
+  if (by_priority_.erase(key) > 0) {
+    stats_.bytes -= atv.size;
+  }
+  atvs_changed_ |= stored_atvs_.erase(atv->getStronglyEquivalencyId()) > 0;
+}
+
+void MemPool::eraseVTB(relations_map_t::iterator rel, const VTB::id_t& id) {
+  auto& vtbs = rel->second->vtbs;
+  auto it = std::find_if(
+      vtbs.begin(), vtbs.end(), [&id](const SizedPayload<VTB>& vtb) {
+        return vtb->getId() == id;
+      });
+  if (it != vtbs.end()) {
+    forget(*rel, *it);
+    vtbs.erase(it);
+  }
+}
+
+void MemPool::eraseATV(relations_map_t::iterator rel, const ATV::id_t& id) {
+  auto& atvs = rel->second->atvs;
+  auto it = std::find_if(
+      atvs.begin(), atvs.end(), [&id](const SizedPayload<ATV>& atv) {
+        return atv->getId() == id;
+      });
+  if (it != atvs.end()) {
+    forget(*rel, *it);
+    atvs.erase(it);
+  }
+}
+
+void MemPool::trim() {
+  while (max_size_ > 0 && stats_.bytes > max_size_ &&
+         !by_priority_.empty()) {
+    auto key = *by_priority_.begin();
+    auto rel = relations_.find(key.relation);
+    VBK_ASSERT(rel != relations_.end());
+    switch (key.kind) {
+      case PriorityKey::Kind::VTB:
+        eraseVTB(rel, key.id);
+        ++stats_.evictedVtbs;
+        break;
+      case PriorityKey::Kind::ATV:
+        eraseATV(rel, key.id);
+        ++stats_.evictedAtvs;
+        break;
+      case PriorityKey::Kind::VBK_BLOCK:
+        // payloads of the relation have lower priority, and are gone already
+        stats_.evictedVtbs += rel->second->vtbs.size();
+        stats_.evictedAtvs += rel->second->atvs.size();
+        ++stats_.evictedVbkBlocks;
+        removeRelation(rel);
         continue;
+    }
+    // evicted payload was the only reason to keep this VBK block
+    if (rel->second->empty()) {
+      ++stats_.evictedVbkBlocks;
+      removeRelation(rel);
+    }
+  }
+}
+
+bool MemPool::fits(const PriorityKey& key, size_t bytes) const {
+  if (max_size_ == 0 || stats_.bytes + bytes <= max_size_) {
+    return true;
+  }
+
+  size_t needed = stats_.bytes + bytes - max_size_;
+  size_t freed = 0;
+  for (auto it = by_priority_.begin();
+       it != by_priority_.end() && *it < key;
+       ++it) {
+    freed += it->size;
+    if (freed >= needed) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MemPool::setMaxSize(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_size_ = bytes;
+  trim();
+  publish();
+}
+
+MemPool::Stats MemPool::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats ret = stats_;
+  ret.orphans = orphan_vbkblocks_.size() + orphan_vtbs_.size();
+  return ret;
+}
+
+void MemPool::admitOrphans() {
+  while (!new_vbk_parents_.empty() || !new_btc_parents_.empty()) {
+    if (!new_vbk_parents_.empty()) {
+      auto parent = new_vbk_parents_.back();
+      new_vbk_parents_.pop_back();
+      for (const auto& blk : takeOrphans(orphan_vbkblocks_, parent)) {
+        ValidationState state;
+        add(blk, state, true);
       }
+      continue;
+    }
+
+    auto parent = new_btc_parents_.back();
+    new_btc_parents_.pop_back();
+    for (const auto& vtb : takeOrphans(orphan_vtbs_, parent)) {
+      ValidationState state;
+      add(vtb, state, true);
     }
+  }
+}
 
-    // if header is recently added to new block or relation is empty, cleanup
-    if (vbkblockids.count(rel.header->getId()) && rel.empty()) {
+void MemPool::vacuumOrphans() {
+  auto& vbk = tree_->vbk();
+  auto* tip = vbk.getBestChain().tip();
+  auto maxReorgBlocks = vbk.getParams().getMaxReorgBlocks();
+  auto tooOld = [&](int32_t height) {
+    return tip->getHeight() - maxReorgBlocks > height;
+  };
+
+  for (auto it = orphan_vbkblocks_.begin(); it != orphan_vbkblocks_.end();) {
+    it = tooOld(it->second.height) ? orphan_vbkblocks_.erase(it)
+                                   : std::next(it);
+  }
+  for (auto it = orphan_vtbs_.begin(); it != orphan_vtbs_.end();) {
+    it = tooOld(it->second.containingBlock.height) ? orphan_vtbs_.erase(it)
+                                                   : std::next(it);
+  }
+}
+
+void MemPool::publish() {
+  auto previous = std::atomic_load(&snapshot_);
+  auto snapshot = std::make_shared<Snapshot>();
+  if (vbkblocks_changed_ || previous == nullptr) {
+    snapshot->vbkblocks = std::make_shared<const vbkblock_map_t>(vbkblocks_);
+  } else {
+    snapshot->vbkblocks = previous->vbkblocks;
+  }
+  if (atvs_changed_ || previous == nullptr) {
+    snapshot->atvs = std::make_shared<const atv_map_t>(stored_atvs_);
+  } else {
+    snapshot->atvs = previous->atvs;
+  }
+  if (vtbs_changed_ || previous == nullptr) {
+    snapshot->vtbs = std::make_shared<const vtb_map_t>(stored_vtbs_);
+  } else {
+    snapshot->vtbs = previous->vtbs;
+  }
+  vbkblocks_changed_ = atvs_changed_ = vtbs_changed_ = false;
+  std::atomic_store(&snapshot_,
+                    std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
+void MemPool::emitAccepted() {
+  std::vector<ATV> atvs;
+  std::vector<VTB> vtbs;
+  std::vector<VbkBlock> vbkblocks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    atvs.swap(pending_atvs_);
+    vtbs.swap(pending_vtbs_);
+    vbkblocks.swap(pending_vbkblocks_);
+  }
+
+  for (const auto& b : vbkblocks) {
+    on_vbkblock_accepted.emit(b);
+  }
+  for (const auto& vtb : vtbs) {
+    on_vtb_accepted.emit(vtb);
+  }
+  for (const auto& atv : atvs) {
+    on_atv_accepted.emit(atv);
+  }
+}
+
+void MemPool::indexATVExpiry(const ATV& atv) {
+  auto strong_id = atv.getStronglyEquivalencyId();
+  auto endorsed_hash =
+      tree_->getParams().getHash(atv.transaction.publicationData.header);
+  auto* endorsed_index = tree_->getBlockIndex(endorsed_hash);
+  if (endorsed_index == nullptr) {
+    atvs_unknown_endorsed_.insert(strong_id);
+    return;
+  }
+
+  // see checkContextually<ATV>: ATV expires when ALT tip reaches this height
+  int32_t window = tree_->getParams().getEndorsementSettlementInterval();
+  atvs_by_expiry_.insert({endorsed_index->getHeight() + window, strong_id});
+}
+
+void MemPool::vacuum(const PopData& pop) {
+  VacuumContext ctx(pop);
+  auto& vbk = tree_->vbk();
+  auto* tip = vbk.getBestChain().tip();
+  auto maxReorgBlocks = vbk.getParams().getMaxReorgBlocks();
+
+  for (auto it = relations_.begin(); it != relations_.end();) {
+    bool tooOld = tip->getHeight() - maxReorgBlocks > it->second->header->height;
+    if (tooOld) {
+      // VBK block is too old to be included or modified
       it = removeRelation(it);
       continue;
     }
 
-    ++it;
+    it = cleanupRelation(it, ctx);
+  }
+
+  // full scan has just dropped every stale ATV, rebuild expiry index
+  atvs_by_expiry_.clear();
+  atvs_unknown_endorsed_.clear();
+  for (const auto& p : stored_atvs_) {
+    indexATVExpiry(*p.second);
   }
 }
 
-void MemPool::removePayloads(const PopData& pop) { vacuum(pop); }
+void MemPool::evict(const PopData& pop) {
+  VacuumContext ctx(pop);
+  auto& vbk = tree_->vbk();
+  auto* vbkTip = vbk.getBestChain().tip();
+  auto* altTip = tree_->getBestChain().tip();
+  auto maxReorgBlocks = vbk.getParams().getMaxReorgBlocks();
+
+  // VBK blocks, which are too old to be included or modified, are at the
+  // beginning of height index
+  while (!relations_by_height_.empty() &&
+         vbkTip->getHeight() - maxReorgBlocks >
+             relations_by_height_.begin()->first) {
+    auto it = relations_.find(relations_by_height_.begin()->second);
+    VBK_ASSERT(it != relations_.end());
+    removeRelation(it);
+  }
+
+  // ATVs which endorse recently accepted ALT blocks get their expiry height
+  for (auto it = atvs_unknown_endorsed_.begin();
+       it != atvs_unknown_endorsed_.end();) {
+    auto atv = stored_atvs_.find(*it);
+    if (atv == stored_atvs_.end()) {
+      it = atvs_unknown_endorsed_.erase(it);
+      continue;
+    }
+
+    auto endorsed_hash = tree_->getParams().getHash(
+        atv->second->transaction.publicationData.header);
+    if (tree_->getBlockIndex(endorsed_hash) == nullptr) {
+      ++it;
+      continue;
+    }
+
+    auto ptr = atv->second;
+    it = atvs_unknown_endorsed_.erase(it);
+    indexATVExpiry(*ptr);
+  }
+
+  // expired ATVs. Entries of already removed ATVs are skipped.
+  while (!atvs_by_expiry_.empty() &&
+         atvs_by_expiry_.begin()->first <= altTip->getHeight()) {
+    auto stored = stored_atvs_.find(atvs_by_expiry_.begin()->second);
+    if (stored != stored_atvs_.end()) {
+      auto rel = relations_.find(stored->second->blockOfProof.getId());
+      VBK_ASSERT(rel != relations_.end());
+      eraseATV(rel, stored->first);
+    }
+    atvs_by_expiry_.erase(atvs_by_expiry_.begin());
+  }
+
+  // only relations touched by `pop` can change their state
+  std::set<VbkBlock::id_t> touched(ctx.vbkblock_ids);
+  for (const auto& vtb : pop.vtbs) {
+    touched.insert(vtb.containingBlock.getId());
+    // strongly equivalent VTBs are stale in every relation
+    auto range = vtb_relations_.equal_range(vtb.getStronglyEquivalencyId());
+    for (auto it = range.first; it != range.second; ++it) {
+      touched.insert(it->second);
+    }
+  }
+  for (const auto& atv : pop.atvs) {
+    touched.insert(atv.blockOfProof.getId());
+    auto stored = stored_atvs_.find(atv.getStronglyEquivalencyId());
+    if (stored != stored_atvs_.end()) {
+      touched.insert(stored->second->blockOfProof.getId());
+    }
+  }
+
+  for (const auto& id : touched) {
+    auto it = relations_.find(id);
+    if (it != relations_.end()) {
+      cleanupRelation(it, ctx);
+    }
+  }
+}
+
+void MemPool::removePayloads(const PopData& pop) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto* tip = tree_->getBestChain().tip();
+    VBK_ASSERT(tip != nullptr && "block tree is not bootstrapped");
+    // when ALT tip has moved by at most one block, only payloads from `pop`
+    // and expired payloads have to be evicted. Any other tip change (reorg,
+    // several blocks connected at once) may change state of any payload, so
+    // all relations are rechecked.
+    bool extendsLastTip =
+        !vacuum_tip_.empty() &&
+        (tip->getHash() == vacuum_tip_ ||
+         (tip->pprev != nullptr && tip->pprev->getHash() == vacuum_tip_));
+    if (extendsLastTip) {
+      evict(pop);
+    } else {
+      vacuum(pop);
+    }
+    vacuum_tip_ = tip->getHash();
+
+    // blocks from `pop` are now known to VBK and BTC trees
+    vacuumOrphans();
+    if (!orphan_vbkblocks_.empty()) {
+      for (const auto& b : pop.context) {
+        new_vbk_parents_.push_back(b.getId());
+      }
+    }
+    if (!orphan_vtbs_.empty()) {
+      for (const auto& vtb : pop.vtbs) {
+        auto hashes = btcBlocksOf(vtb);
+        new_btc_parents_.insert(
+            new_btc_parents_.end(), hashes.begin(), hashes.end());
+      }
+    }
+    admitOrphans();
+    publish();
+  }
+  emitAccepted();
+}
 
 MemPool::VbkPayloadsRelations& MemPool::touchVbkBlock(const VbkBlock& block,
                                                       VbkBlock::id_t block_id) {
@@ -239,13 +669,25 @@ MemPool::VbkPayloadsRelations& MemPool::touchVbkBlock(const VbkBlock& block,
   std::shared_ptr<VbkBlock> vbk_block = std::make_shared<VbkBlock>(block);
 
   vbkblocks_[block_id] = vbk_block;
+  vbkblocks_changed_ = true;
 
   auto& val = relations_[block_id];
   if (val == nullptr) {
     val = std::make_shared<VbkPayloadsRelations>(vbk_block);
+    relations_by_height_.insert({block.height, block_id});
+    by_priority_.insert({block.height,
+                         kVbkBlockSize,
+                         PriorityKey::Kind::VBK_BLOCK,
+                         block_id,
+                         uint256()});
+    stats_.bytes += kVbkBlockSize;
   }
 
-  on_vbkblock_accepted.emit(block);
+  if (!orphan_vbkblocks_.empty()) {
+    new_vbk_parents_.push_back(block_id);
+  }
+
+  pending_vbkblocks_.push_back(block);
 
   return *val;
 }
@@ -264,23 +706,134 @@ void process_submit(
   }
 }
 
+// submit payloads, which have already been checked statelessly in a batch
+template <typename pop_t>
+void process_submit(
+    MemPool& memPool,
+    const std::vector<pop_t>& payloads,
+    const std::vector<ValidationState>& stateless,
+    const std::string& statelessReason,
+    std::vector<std::pair<typename pop_t::id_t, ValidationState>>& res) {
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    const auto& p = payloads[i];
+    ValidationState state = stateless[i];
+    if (state.IsValid()) {
+      // stateless checks passed, submit will not repeat them
+      memPool.submit<pop_t>(p, state);
+    } else {
+      state.Invalid(statelessReason);
+    }
+    res.emplace_back(p.getId(), state);
+  }
+}
+
 }  // namespace
 
 MempoolResult MemPool::submitAll(const PopData& pop) {
   MempoolResult r;
 
+  std::vector<ValidationState> vtbStates;
+  std::vector<ValidationState> atvStates;
+  checkVTBs(pop.vtbs, vtbStates, tree_->btc().getParams(), pool_.get());
+  checkATVs(pop.atvs, atvStates, tree_->getParams(), pool_.get());
+
   process_submit(*this, pop.context, r.context);
-  process_submit(*this, pop.vtbs, r.vtbs);
-  process_submit(*this, pop.atvs, r.atvs);
+  process_submit(*this,
+                 pop.vtbs,
+                 vtbStates,
+                 "pop-mempool-submit-vtb-stateless",
+                 r.vtbs);
+  process_submit(*this,
+                 pop.atvs,
+                 atvStates,
+                 "pop-mempool-submit-atv-stateless",
+                 r.atvs);
 
   return r;
 }
 
+namespace {
+
+// results of stored payloads are valid, others come from `submitted` in order
+template <typename id_t>
+void mergeResults(const std::vector<id_t>& ids,
+                  const std::vector<bool>& stored,
+                  std::vector<std::pair<id_t, ValidationState>>& submitted) {
+  std::vector<std::pair<id_t, ValidationState>> merged;
+  merged.reserve(ids.size());
+  size_t next = 0;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (stored[i]) {
+      merged.emplace_back(ids[i], ValidationState());
+    } else {
+      VBK_ASSERT(next < submitted.size());
+      merged.push_back(std::move(submitted[next++]));
+    }
+  }
+  submitted.swap(merged);
+}
+
+}  // namespace
+
+MempoolResult MemPool::submitAll(Slice<const uint8_t> encodedPopData) {
+  auto view = PopDataView::fromVbkEncoding(encodedPopData);
+  auto snapshot = getSnapshot();
+
+  PopData pop;
+  pop.version = view.version;
+  pop.context = std::move(view.context);
+
+  std::vector<VTB::id_t> vtbIds;
+  std::vector<bool> vtbStored;
+  for (const auto& vtb : view.vtbs) {
+    auto id = vtb.getId();
+    auto it = snapshot->vtbs->find(vtb.getStronglyEquivalencyId());
+    bool stored = it != snapshot->vtbs->end() && it->second->getId() == id;
+    if (!stored) {
+      pop.vtbs.push_back(vtb.toVTB());
+    }
+    vtbIds.push_back(id);
+    vtbStored.push_back(stored);
+  }
+
+  std::vector<ATV::id_t> atvIds;
+  std::vector<bool> atvStored;
+  for (const auto& atv : view.atvs) {
+    auto id = atv.getId();
+    bool stored = snapshot->atvs->count(id) > 0;
+    if (!stored) {
+      pop.atvs.push_back(atv.toATV());
+    }
+    atvIds.push_back(id);
+    atvStored.push_back(stored);
+  }
+
+  auto r = submitAll(pop);
+  mergeResults(vtbIds, vtbStored, r.vtbs);
+  mergeResults(atvIds, atvStored, r.atvs);
+  return r;
+}
+
 void MemPool::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
   relations_.clear();
+  relations_by_height_.clear();
+  atvs_by_expiry_.clear();
+  atvs_unknown_endorsed_.clear();
+  vacuum_tip_.clear();
+  by_priority_.clear();
+  stats_.bytes = 0;
+  orphan_vbkblocks_.clear();
+  orphan_vtbs_.clear();
+  btc_provided_.clear();
+  new_vbk_parents_.clear();
+  new_btc_parents_.clear();
   vbkblocks_.clear();
   stored_vtbs_.clear();
+  vtb_relations_.clear();
   stored_atvs_.clear();
+  vbkblocks_changed_ = atvs_changed_ = vtbs_changed_ = true;
+  publish();
 }
 
 template <>
@@ -292,20 +845,53 @@ bool MemPool::submit(const ATV& atv,
     return state.Invalid("pop-mempool-submit-atv-stateless");
   }
 
+  bool ret = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ret = add(atv, state, shouldDoContextualCheck);
+    admitOrphans();
+    publish();
+  }
+  emitAccepted();
+  return ret;
+}
+
+template <>
+bool MemPool::add(const ATV& atv,
+                  ValidationState& state,
+                  bool shouldDoContextualCheck) {
   // stateful validation
   if (shouldDoContextualCheck && !checkContextually(atv, state)) {
     return state.Invalid("pop-mempool-submit-atv-stateful");
   }
 
-  auto& rel = touchVbkBlock(atv.blockOfProof);
-  auto atvptr = std::make_shared<ATV>(atv);
-  auto pair = std::make_pair(atv.getStronglyEquivalencyId(), atvptr);
-  rel.atvs.push_back(atvptr);
+  auto strong_id = atv.getStronglyEquivalencyId();
+  if (stored_atvs_.count(strong_id) > 0) {
+    // already in mempool
+    return true;
+  }
 
-  // store atv id in containing block index
-  stored_atvs_.insert(pair);
+  auto rel_id = atv.blockOfProof.getId();
+  SizedPayload<ATV> sized(std::make_shared<ATV>(atv));
+  PriorityKey key{atv.blockOfProof.height,
+                  sized.size,
+                  PriorityKey::Kind::ATV,
+                  rel_id,
+                  atv.getId()};
+  size_t bytes =
+      sized.size + (relations_.count(rel_id) > 0 ? 0 : kVbkBlockSize);
+  if (!fits(key, bytes)) {
+    return state.Invalid("pop-mempool-submit-atv-full",
+                         "ATV has lower priority than all stored payloads");
+  }
+
+  touchVbkBlock(atv.blockOfProof, rel_id);
+  remember(rel_id, sized);
+  indexATVExpiry(atv);
+  trim();
+  VBK_ASSERT(by_priority_.count(key) > 0);
 
-  on_atv_accepted.emit(atv);
+  pending_atvs_.push_back(atv);
 
   return true;
 }
@@ -314,25 +900,81 @@ template <>
 bool MemPool::submit(const VTB& vtb,
                      ValidationState& state,
                      bool shouldDoContextualCheck) {
-  auto& vbk = tree_->vbk();
   // stateless validation
-  if (!checkVTB(vtb, state, vbk.btc().getParams())) {
+  if (!checkVTB(vtb, state, tree_->btc().getParams())) {
     return state.Invalid("pop-mempool-submit-vtb-stateless");
   }
 
+  bool ret = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ret = add(vtb, state, shouldDoContextualCheck);
+    admitOrphans();
+    publish();
+  }
+  emitAccepted();
+  return ret;
+}
+
+template <>
+bool MemPool::add(const VTB& vtb,
+                  ValidationState& state,
+                  bool shouldDoContextualCheck) {
   // stateful validation
   if (shouldDoContextualCheck && !checkContextually(vtb, state)) {
     return state.Invalid("pop-mempool-submit-vtb-stateful");
   }
 
-  auto& rel = touchVbkBlock(vtb.containingBlock);
-  auto vtbptr = std::make_shared<VTB>(vtb);
-  auto pair = std::make_pair(vtb.getStronglyEquivalencyId(), vtbptr);
-  rel.vtbs.push_back(vtbptr);
+  auto connecting = connectingBtcHash(vtb);
+  if (shouldDoContextualCheck &&
+      tree_->btc().getBlockIndex(connecting) == nullptr &&
+      btc_provided_.count(connecting) == 0) {
+    // BTC context may be provided later
+    if (addOrphan(orphan_vtbs_,
+                  connecting,
+                  vtb,
+                  orphan_vbkblocks_.size() + orphan_vtbs_.size())) {
+      return state.Invalid(
+          "pop-mempool-submit-vtb-orphan",
+          fmt::sprintf("VTB=%s BTC context connects to unknown block %s",
+                       vtb.getId().toHex(),
+                       connecting.toHex()));
+    }
+    return state.Invalid("pop-mempool-submit-vtb-stateful",
+                         "vtb-btc-context-unknown-previous-block");
+  }
+
+  auto rel_id = vtb.containingBlock.getId();
+  auto id = vtb.getId();
+  auto rel = relations_.find(rel_id);
+  if (rel != relations_.end() &&
+      std::any_of(rel->second->vtbs.begin(),
+                  rel->second->vtbs.end(),
+                  [&id](const SizedPayload<VTB>& p) {
+                    return p->getId() == id;
+                  })) {
+    // already in mempool
+    return true;
+  }
+
+  SizedPayload<VTB> sized(std::make_shared<VTB>(vtb));
+  PriorityKey key{vtb.containingBlock.height,
+                  sized.size,
+                  PriorityKey::Kind::VTB,
+                  rel_id,
+                  id};
+  size_t bytes = sized.size + (rel != relations_.end() ? 0 : kVbkBlockSize);
+  if (!fits(key, bytes)) {
+    return state.Invalid("pop-mempool-submit-vtb-full",
+                         "VTB has lower priority than all stored payloads");
+  }
 
-  stored_vtbs_.insert(pair);
+  touchVbkBlock(vtb.containingBlock, rel_id);
+  remember(rel_id, sized);
+  trim();
+  VBK_ASSERT(by_priority_.count(key) > 0);
 
-  on_vtb_accepted.emit(vtb);
+  pending_vtbs_.push_back(vtb);
 
   return true;
 }
@@ -346,32 +988,62 @@ bool MemPool::submit(const VbkBlock& blk,
     return state.Invalid("pop-mempool-submit-vbkblock-stateless");
   }
 
+  bool ret = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ret = add(blk, state, shouldDoContextualCheck);
+    admitOrphans();
+    publish();
+  }
+  emitAccepted();
+  return ret;
+}
+
+template <>
+bool MemPool::add(const VbkBlock& blk,
+                  ValidationState& state,
+                  bool shouldDoContextualCheck) {
   if (shouldDoContextualCheck && !checkContextually(blk, state)) {
+    // previous block may be submitted later
+    if (addOrphan(orphan_vbkblocks_,
+                  blk.previousBlock,
+                  blk,
+                  orphan_vbkblocks_.size() + orphan_vtbs_.size())) {
+      return state.Invalid("pop-mempool-submit-vbk-orphan");
+    }
     return state.Invalid("pop-mempool-submit-vbk-stateful");
   }
 
   // stateful validation
   if (!shouldDoContextualCheck || !tree_->vbk().getBlockIndex(blk.getHash())) {
-    // duplicate
-    touchVbkBlock(blk, blk.getId());
+    auto id = blk.getId();
+    PriorityKey key{
+        blk.height, kVbkBlockSize, PriorityKey::Kind::VBK_BLOCK, id, uint256()};
+    if (relations_.count(id) == 0 && !fits(key, kVbkBlockSize)) {
+      return state.Invalid(
+          "pop-mempool-submit-vbk-full",
+          "VBK block has lower priority than all stored payloads");
+    }
+    touchVbkBlock(blk, id);
+    trim();
   }
 
   return true;
 }
 
 template <>
-const MemPool::payload_map<VbkBlock>& MemPool::getMap() const {
-  return vbkblocks_;
+const MemPool::payload_map<VbkBlock>& MemPool::Snapshot::getMap() const {
+  return *vbkblocks;
 }
 
 template <>
-const MemPool::payload_map<ATV>& MemPool::getMap() const {
-  return stored_atvs_;
+const MemPool::payload_map<ATV>& MemPool::Snapshot::getMap() const {
+  return *atvs;
 }
 
 template <>
-const MemPool::payload_map<VTB>& MemPool::getMap() const {
-  return stored_vtbs_;
+const MemPool::payload_map<VTB>& MemPool::Snapshot::getMap() const {
+  return *vtbs;
 }
 
 template <>
@@ -457,7 +1129,7 @@ template <>
 bool MemPool::checkContextually<VbkBlock>(const VbkBlock& blk,
                                           ValidationState& state) {
   if (tree_->vbk().getBlockIndex(blk.previousBlock) == nullptr &&
-      get<VbkBlock>(blk.previousBlock) == nullptr) {
+      vbkblocks_.count(blk.previousBlock) == 0) {
     return state.Invalid(
         "bad-prev",
         fmt::sprintf("Block=%s does not connect to known VBK tree",
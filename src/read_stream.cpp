@@ -60,6 +60,15 @@ Slice<const uint8_t> ReadStream::data() const {
   return Slice<const uint8_t>(m_Buffer, m_Size);
 }
 
+void ReadStream::read(size_t size, void *out) {
+  if (!hasMore(size)) {
+    throw std::out_of_range("stream.read(): out of data");
+  }
+
+  std::memcpy(out, m_Buffer + m_Pos, size);
+  m_Pos += size;
+}
+
 std::vector<uint8_t> ReadStream::read(size_t size) {
   return read<std::vector<uint8_t>>(size);
 }
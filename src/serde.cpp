@@ -8,7 +8,10 @@
 
 namespace altintegration {
 
-std::vector<uint8_t> trimmedArray(int64_t input) {
+namespace {
+
+// number of significant bytes in `input`, at least 1
+size_t trimmedSize(int64_t input) {
   size_t x = sizeof(int64_t);
   do {
     if ((input >> ((x - 1) * 8)) != 0) {
@@ -16,7 +19,13 @@ std::vector<uint8_t> trimmedArray(int64_t input) {
     }
     x--;
   } while (x > 1);
+  return x;
+}
 
+}  // namespace
+
+std::vector<uint8_t> trimmedArray(int64_t input) {
+  size_t x = trimmedSize(input);
   std::vector<uint8_t> output(x);
   for (size_t i = 0; i < x; i++) {
     output[x - i - 1] = (uint8_t)input;
@@ -26,6 +35,8 @@ std::vector<uint8_t> trimmedArray(int64_t input) {
   return output;
 }
 
+size_t singleBEValueSize(int64_t value) { return 1 + trimmedSize(value); }
+
 Slice<const uint8_t> readVarLenValue(ReadStream& stream,
                                      int minLen,
                                      int maxLen) {
@@ -49,9 +60,13 @@ void writeSingleByteLenValue(WriteStream& stream, Slice<const uint8_t> value) {
 }
 
 void writeSingleBEValue(WriteStream& stream, int64_t value) {
-  std::vector<uint8_t> dataBytes = trimmedArray(value);
-  stream.writeBE<uint8_t>((uint8_t)dataBytes.size());
-  stream.write(dataBytes);
+  uint8_t buf[1 + sizeof(int64_t)];
+  size_t x = trimmedSize(value);
+  buf[0] = (uint8_t)x;
+  for (size_t i = x; i > 0; i--) {
+    buf[1 + x - i] = (uint8_t)(value >> ((i - 1) * 8));
+  }
+  stream.write(buf, 1 + x);
 }
 
 void writeVarLenValue(WriteStream& stream, Slice<const uint8_t> value) {
@@ -59,6 +74,42 @@ void writeVarLenValue(WriteStream& stream, Slice<const uint8_t> value) {
   stream.write(value);
 }
 
+void writeVarInt(WriteStream& stream, uint64_t value) {
+  uint8_t buf[10];
+  size_t size = 0;
+  while (value >= 0x80) {
+    buf[size++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buf[size++] = (uint8_t)value;
+  stream.write(buf, size);
+}
+
+uint64_t readVarInt(ReadStream& stream) {
+  uint64_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    const auto byte = stream.readBE<uint8_t>();
+    // 10th byte may only carry the highest bit of the value
+    if (shift == 63 && byte > 1) {
+      throw std::out_of_range("readVarInt(): value overflow");
+    }
+    value |= (uint64_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::out_of_range("readVarInt(): value overflow");
+}
+
+size_t varIntSize(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
 NetworkBytePair readNetworkByte(ReadStream& stream, TxType type) {
   NetworkBytePair ret;
   auto networkOrType = stream.readBE<uint8_t>();
@@ -83,14 +134,14 @@ void writeNetworkByte(WriteStream& stream, NetworkBytePair networkOrType) {
 
 std::string readString(ReadStream& stream) {
   const auto count = readSingleBEValue<int32_t>(stream);
-
-  std::string result;
-  result.reserve(count);
-
-  for (int32_t i = 0; i < count; ++i) {
-    result.push_back(stream.readBE<char>());
+  if (count <= 0) {
+    return std::string();
   }
-
+  if (!stream.hasMore((size_t)count)) {
+    throw std::out_of_range("readString(): out of data");
+  }
+  std::string result((size_t)count, '\0');
+  stream.read(result.size(), &result[0]);
   return result;
 }
 
@@ -5,8 +5,12 @@
 
 #include "veriblock/signutil.hpp"
 
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <veriblock/assert.hpp>
+#include <veriblock/hashers.hpp>
 
 #include "veriblock/hashutil.hpp"
 #include "veriblock/strutil.hpp"
@@ -104,6 +108,43 @@ static PublicKey publicKeyAsn1ToUncompressed(Slice<const uint8_t> publicKey) {
   return result;
 }
 
+static_assert(sizeof(ParsedPublicKey) == sizeof(secp256k1_pubkey),
+              "ParsedPublicKey must be able to hold secp256k1_pubkey");
+
+//! max number of parsed public keys kept in memory
+static const size_t MAX_PARSED_PUBKEY_CACHE_SIZE = 10000;
+
+// VBK encoded public key -> parsed public key
+struct ParsedPublicKeyCache {
+  bool get(const std::vector<uint8_t>& key, ParsedPublicKey& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+      return false;
+    }
+    out = it->second;
+    return true;
+  }
+
+  void put(const std::vector<uint8_t>& key, const ParsedPublicKey& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cache_.size() >= MAX_PARSED_PUBKEY_CACHE_SIZE) {
+      // keys are cheap to re-parse, so do not bother with LRU
+      cache_.erase(cache_.begin());
+    }
+    cache_[key] = value;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::vector<uint8_t>, ParsedPublicKey> cache_;
+};
+
+static ParsedPublicKeyCache& getParsedPublicKeyCache() {
+  static ParsedPublicKeyCache cache;
+  return cache;
+}
+
 PrivateKey privateKeyFromVbk(PrivateKeyVbk key) {
   checkLength(key.size(),
               PRIVATE_KEY_ASN1_SIZE,
@@ -198,4 +239,49 @@ int veriBlockVerify(Slice<const uint8_t> message,
       ctx, &normalizedSignature, messageHash.data(), &pubkey);
 }
 
+bool parsePublicKeyVbk(Slice<const uint8_t> key, ParsedPublicKey& out) {
+  auto& cache = getParsedPublicKeyCache();
+  auto bytes = key.asVector();
+  if (cache.get(bytes, out)) {
+    return true;
+  }
+
+  secp256k1_pubkey pubkey;
+  try {
+    auto uncompressed = publicKeyFromVbk(bytes);
+    if (!secp256k1_ec_pubkey_parse(
+            ctx, &pubkey, uncompressed.data(), uncompressed.size())) {
+      return false;
+    }
+  } catch (const std::exception&) {
+    return false;
+  }
+
+  std::memcpy(out.data, pubkey.data, sizeof(out.data));
+  cache.put(bytes, out);
+  return true;
+}
+
+int veriBlockVerify(Slice<const uint8_t> message,
+                    Slice<const uint8_t> signature,
+                    const ParsedPublicKey& publicKey) {
+  secp256k1_pubkey pubkey;
+  std::memcpy(pubkey.data, publicKey.data, sizeof(pubkey.data));
+
+  secp256k1_ecdsa_signature signatureDecoded;
+  if (!secp256k1_ecdsa_signature_parse_der(
+          ctx, &signatureDecoded, signature.data(), signature.size())) {
+    return 0;
+  }
+
+  // FIXME: Fix this on the other side. We should accept the lower-S form only.
+  secp256k1_ecdsa_signature normalizedSignature;
+  secp256k1_ecdsa_signature_normalize(
+      ctx, &normalizedSignature, &signatureDecoded);
+
+  auto messageHash = sha256(message);
+  return secp256k1_ecdsa_verify(
+      ctx, &normalizedSignature, messageHash.data(), &pubkey);
+}
+
 }  // namespace altintegration
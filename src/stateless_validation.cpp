@@ -4,127 +4,122 @@
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
 #include <algorithm>
-#include <bitset>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <veriblock/blockchain/alt_chain_params.hpp>
+#include <veriblock/hashers.hpp>
 
 #include "veriblock/arith_uint256.hpp"
 #include "veriblock/blob.hpp"
+#include "veriblock/bytesearch.hpp"
 #include "veriblock/consts.hpp"
 #include "veriblock/stateless_validation.hpp"
+#include "veriblock/stateless_validation_cache.hpp"
 #include "veriblock/strutil.hpp"
 
 namespace {
 
-int getIntFromBits(const std::vector<bool>& bits,
-                   const uint32_t& fromIndex,
-                   const uint32_t& toIndex) {
-  int value = 0;
-  for (size_t j = fromIndex; j < toIndex; ++j) {
-    if (bits[j]) {
-      value += 1 << (j - fromIndex);
+// Chunk descriptor is a big-endian bit string: bit 0 is the least significant
+// bit of its last byte. Reads bits directly from the transaction bytes.
+struct ChunkDescriptorReader {
+  explicit ChunkDescriptorReader(altintegration::Slice<const uint8_t> bytes)
+      : bytes_(bytes) {}
+
+  //! value of bits [from, to), bit `from` being the least significant one
+  uint32_t get(uint32_t from, uint32_t to) const {
+    to = (std::min)(to, (uint32_t)bytes_.size() * 8);
+    uint32_t value = 0;
+    for (uint32_t j = from; j < to; ++j) {
+      const uint8_t byte = bytes_[bytes_.size() - 1 - j / 8];
+      value |= (uint32_t)((byte >> (j % 8)) & 1) << (j - from);
     }
+    return value;
   }
-  return value;
-}
 
-};  // namespace
+ private:
+  altintegration::Slice<const uint8_t> bytes_;
+};
+
+}  // namespace
 
 namespace altintegration {
 
 bool containsSplit(const std::vector<uint8_t>& pop_data,
                    const std::vector<uint8_t>& btcTx_data) {
-  static const std::vector<uint8_t> magicBytes = {0x92, 0x7a, 0x59};
-
-  ReadStream buffer(btcTx_data);
-
-  try {
-    size_t lastPos = 0;
-    while (buffer.remaining() > 5) {
-      if (buffer.readBE<uint8_t>() != magicBytes[0] ||
-          buffer.readBE<uint8_t>() != magicBytes[1] ||
-          buffer.readBE<uint8_t>() != magicBytes[2]) {
-        continue;
-      }
-
-      lastPos = buffer.position();
-      // Parse the first byte to get the number of chunks, their positions and
-      // lengths
-      auto descriptor = buffer.readBE<uint8_t>();
-
-      uint32_t chunks = 0;
-      uint32_t offsetLength = 4;
-      uint32_t sectionLength = 4;
-      for (int i = 0; i < 8; ++i) {
-        if ((descriptor >> i) & 1) {
-          if (i < 2) {
-            sectionLength += 1 << i;
-          } else if (i < 4) {
-            offsetLength += 1 << i;
-          } else {
-            chunks += 1 << (i - 4);
-          }
-        }
-      }
+  static const uint8_t magicBytes[] = {0x92, 0x7a, 0x59};
+  const Slice<const uint8_t> magic(magicBytes, sizeof(magicBytes));
+  const Slice<const uint8_t> tx(btcTx_data.data(), btcTx_data.size());
+  const size_t size = tx.size();
+
+  size_t pos = 0;
+  for (;;) {
+    pos = findBytes(tx, magic, pos);
+    // magic, descriptor and at least 2 more bytes have to fit
+    if (pos == size || size - pos <= 5) {
+      return false;
+    }
+    pos += magic.size();
+
+    // Parse the first byte to get the number of chunks, their positions and
+    // lengths
+    const uint8_t descriptor = tx[pos];
+    uint32_t chunks = descriptor >> 4;
+    uint32_t offsetLength = 4 + (descriptor & 0x0c);
+    uint32_t sectionLength = 4 + (descriptor & 0x03);
+    if (chunks == 0) {
+      continue;
+    }
 
-      // Parse the actual chunk descriptors now that we know the sizes
-
-      uint32_t chunkDescriptorBitLength =
-          (chunks * offsetLength) + (sectionLength * (chunks - 1));
-      uint32_t chunkDescriptorBytesLength =
-          (chunkDescriptorBitLength + 8 - (chunkDescriptorBitLength % 8)) / 8;
-      uint32_t waste =
-          chunkDescriptorBytesLength * 8 - chunkDescriptorBitLength;
-
-      std::vector<uint8_t> chunkDescriptorBytes =
-          buffer.readSlice(chunkDescriptorBytesLength).reverse();
-      std::vector<bool> chunkDescriptor;
-      // Read from Slice bits
-      uint32_t chunkDescriptorLength = 0;
-      for (const auto& i1 : chunkDescriptorBytes) {
-        std::bitset<8> temp(i1);
-        for (uint32_t i2 = 0; i2 < 8; ++i2) {
-          chunkDescriptor.push_back(temp[i2]);
-          if (temp[i2]) {
-            chunkDescriptorLength = (uint32_t)chunkDescriptor.size();
-          }
-        }
+    // Parse the actual chunk descriptors now that we know the sizes
+    uint32_t chunkDescriptorBitLength =
+        (chunks * offsetLength) + (sectionLength * (chunks - 1));
+    uint32_t chunkDescriptorBytesLength =
+        (chunkDescriptorBitLength + 8 - (chunkDescriptorBitLength % 8)) / 8;
+    uint32_t waste = chunkDescriptorBytesLength * 8 - chunkDescriptorBitLength;
+    if (size - pos - 1 < chunkDescriptorBytesLength) {
+      // descriptor does not fit into tx, stop searching
+      return false;
+    }
+    ChunkDescriptorReader bits(
+        Slice<const uint8_t>(tx.data() + pos + 1, chunkDescriptorBytesLength));
+
+    // compare chunks against pop_data in place, but keep walking through all
+    // chunks: a chunk outside of tx ends the search even after a mismatch
+    bool equal = true;
+    uint32_t totalBytesRead = 0;
+    size_t cursor = 0;
+    for (int i = (int)chunks - 1; i >= 0; --i) {
+      uint32_t chunkOffset = waste + (i * (offsetLength + sectionLength));
+      uint32_t sectionOffsetValue =
+          bits.get(chunkOffset, chunkOffset + offsetLength);
+
+      uint32_t sectionLengthValue = 0;
+      if (i == 0) {
+        sectionLengthValue = (uint32_t)pop_data.size() - totalBytesRead;
+      } else {
+        sectionLengthValue =
+            bits.get(chunkOffset - sectionLength, chunkOffset);
       }
 
-      int totalBytesRead = 0;
-      buffer.setPosition(0);
-      std::vector<uint8_t> extracted;
-      for (int i = chunks - 1; i >= 0; --i) {
-        uint32_t chunkOffset = waste + (i * (offsetLength + sectionLength));
-        uint32_t limit =
-            (std::min)(chunkDescriptorLength, chunkOffset + offsetLength);
-        int sectionOffsetValue =
-            ::getIntFromBits(chunkDescriptor, chunkOffset, limit);
-
-        uint32_t sectionLengthValue = 0;
-        if (i == 0) {
-          sectionLengthValue = (uint32_t)pop_data.size() - totalBytesRead;
-        } else {
-          sectionLengthValue = ::getIntFromBits(
-              chunkDescriptor, chunkOffset - sectionLength, chunkOffset);
-        }
-        buffer.setPosition(buffer.position() + sectionOffsetValue);
-        Slice<const uint8_t> bytes = buffer.readSlice(sectionLengthValue);
-        totalBytesRead += sectionLengthValue;
-        extracted.insert(extracted.end(), bytes.begin(), bytes.end());
+      cursor += sectionOffsetValue;
+      if (cursor > size || size - cursor < sectionLengthValue) {
+        return false;
       }
+      equal = equal &&
+              (size_t)totalBytesRead + sectionLengthValue <= pop_data.size() &&
+              std::equal(tx.data() + cursor,
+                         tx.data() + cursor + sectionLengthValue,
+                         pop_data.data() + totalBytesRead);
+      cursor += sectionLengthValue;
+      totalBytesRead += sectionLengthValue;
+    }
 
-      if (pop_data == extracted) {
-        return true;
-      }
-      buffer.setPosition(lastPos);
+    if (equal && totalBytesRead == pop_data.size()) {
+      return true;
     }
-  } catch (const std::exception&) {
   }
-
-  return false;
-}  // namespace VeriBlock
+}
 
 bool checkBitcoinTransactionForPoPData(const VbkPopTx& tx,
                                        ValidationState& state) {
@@ -133,19 +128,8 @@ bool checkBitcoinTransactionForPoPData(const VbkPopTx& tx,
   tx.address.getPopBytes(stream);
 
   // finding that stream data contains in the tx.bitcoinTransaction
-  for (size_t i = 0, j = 0;
-       i < tx.bitcoinTransaction.tx.size() - stream.data().size() + 1;
-       ++i) {
-    bool found = true;
-    for (; j < stream.data().size(); ++j) {
-      if (tx.bitcoinTransaction.tx[i + j] != stream.data()[j]) {
-        found = false;
-        break;
-      }
-    }
-    if (found) {
-      return true;
-    }
+  if (containsBytes(tx.bitcoinTransaction.tx, stream.data())) {
+    return true;
   }
 
   if (!containsSplit(stream.data(), tx.bitcoinTransaction.tx)) {
@@ -246,13 +230,12 @@ bool checkProofOfWork(const VbkBlock& block, const VbkChainParams& param) {
   return !(blockHash > target);
 }
 
-bool checkVbkPopTx(const VbkPopTx& tx,
-                   ValidationState& state,
-                   const BtcChainParams& btc) {
-  if (!checkSignature(tx, state)) {
-    return state.Invalid("vbk-check-signature");
-  }
+namespace {
 
+// everything checkVbkPopTx does, except for signature verification
+bool checkVbkPopTxWithoutSignature(const VbkPopTx& tx,
+                                   ValidationState& state,
+                                   const BtcChainParams& btc) {
   if (!checkBitcoinTransactionForPoPData(tx, state)) {
     return state.Invalid("vbk-check-btc-tx-for-pop");
   }
@@ -271,6 +254,18 @@ bool checkVbkPopTx(const VbkPopTx& tx,
   return true;
 }
 
+}  // namespace
+
+bool checkVbkPopTx(const VbkPopTx& tx,
+                   ValidationState& state,
+                   const BtcChainParams& btc) {
+  if (!checkSignature(tx, state)) {
+    return state.Invalid("vbk-check-signature");
+  }
+
+  return checkVbkPopTxWithoutSignature(tx, state, btc);
+}
+
 bool checkVbkTx(const VbkTx& tx, ValidationState& state) {
   if (!checkSignature(tx, state)) {
     return state.Invalid("vbk-check-signature");
@@ -278,41 +273,204 @@ bool checkVbkTx(const VbkTx& tx, ValidationState& state) {
   return true;
 }
 
-bool checkSignature(const VbkTx& tx, ValidationState& state) {
-  if (!tx.sourceAddress.isDerivedFromPublicKey(tx.publicKey)) {
-    return state.Invalid("invalid-vbk-tx",
-                         "Vbk transaction contains an invalid public key");
+namespace {
+
+struct SignatureCheckNames {
+  const char* reason;
+  const char* invalidKey;
+  const char* invalidSignature;
+};
+
+const SignatureCheckNames& getSignatureCheckNames(const VbkTx&) {
+  static const SignatureCheckNames names{
+      "invalid-vbk-tx",
+      "Vbk transaction contains an invalid public key",
+      "Vbk transaction is incorrectly signed"};
+  return names;
+}
+
+const SignatureCheckNames& getSignatureCheckNames(const VbkPopTx&) {
+  static const SignatureCheckNames names{
+      "invalid-vbk-pop-tx",
+      "Vbk Pop transaction contains an invalid public key",
+      "Vbk Pop transaction is incorrectly signed"};
+  return names;
+}
+
+const Address& getSourceAddress(const VbkTx& tx) { return tx.sourceAddress; }
+
+const Address& getSourceAddress(const VbkPopTx& tx) { return tx.address; }
+
+template <typename Tx>
+bool checkSignatureImpl(const Tx& tx, ValidationState& state) {
+  const auto& names = getSignatureCheckNames(tx);
+  if (!getSourceAddress(tx).isDerivedFromPublicKey(tx.publicKey)) {
+    return state.Invalid(names.reason, names.invalidKey);
   }
 
+  ParsedPublicKey key;
   auto hash = tx.getHash();
-  if (!veriBlockVerify(hash, tx.signature, publicKeyFromVbk(tx.publicKey))) {
-    return state.Invalid("invalid-vbk-tx",
-                         "Vbk transaction is incorrectly signed");
+  if (!parsePublicKeyVbk(tx.publicKey, key) ||
+      !veriBlockVerify(hash, tx.signature, key)) {
+    return state.Invalid(names.reason, names.invalidSignature);
   }
   return true;
 }
 
-bool checkSignature(const VbkPopTx& tx, ValidationState& state) {
-  if (!tx.address.isDerivedFromPublicKey(tx.publicKey)) {
-    return state.Invalid("invalid-vbk-pop-tx",
-                         "Vbk Pop transaction contains an invalid public key");
+// public key, shared by one or more transactions in a batch
+struct BatchPublicKey {
+  const std::vector<uint8_t>* encoded = nullptr;
+  ParsedPublicKey parsed{};
+  bool valid = false;
+  Address address;
+};
+
+template <typename Tx>
+bool checkSignaturesImpl(Slice<const Tx* const> txes,
+                         std::vector<ValidationState>& states,
+                         ThreadPool* pool) {
+  states.assign(txes.size(), ValidationState());
+
+  // parse every distinct public key and derive its address only once
+  std::unordered_map<std::vector<uint8_t>, size_t> keyIndex;
+  std::vector<BatchPublicKey> keys;
+  std::vector<size_t> txKey(txes.size());
+  for (size_t i = 0; i < txes.size(); ++i) {
+    const auto& pub = txes[i]->publicKey;
+    auto it = keyIndex.find(pub);
+    if (it == keyIndex.end()) {
+      it = keyIndex.emplace(pub, keys.size()).first;
+      keys.emplace_back();
+      keys.back().encoded = &pub;
+    }
+    txKey[i] = it->second;
   }
-  auto hash = tx.getHash();
-  if (!veriBlockVerify(hash, tx.signature, publicKeyFromVbk(tx.publicKey))) {
-    return state.Invalid("invalid-vbk-pop-tx",
-                         "Vbk Pop transaction is incorrectly signed");
+
+  parallelFor(pool, keys.size(), [&keys](size_t k) {
+    auto& key = keys[k];
+    key.valid = parsePublicKeyVbk(*key.encoded, key.parsed);
+    key.address = Address::fromPublicKey(*key.encoded);
+  });
+
+  parallelFor(pool, txes.size(), [&](size_t i) {
+    const auto& tx = *txes[i];
+    const auto& key = keys[txKey[i]];
+    const auto& names = getSignatureCheckNames(tx);
+    if (getSourceAddress(tx) != key.address) {
+      states[i].Invalid(names.reason, names.invalidKey);
+      return;
+    }
+
+    auto hash = tx.getHash();
+    if (!key.valid || !veriBlockVerify(hash, tx.signature, key.parsed)) {
+      states[i].Invalid(names.reason, names.invalidSignature);
+    }
+  });
+
+  return std::all_of(
+      states.begin(), states.end(), [](const ValidationState& state) {
+        return state.IsValid();
+      });
+}
+
+}  // namespace
+
+bool checkSignature(const VbkTx& tx, ValidationState& state) {
+  return checkSignatureImpl(tx, state);
+}
+
+bool checkSignature(const VbkPopTx& tx, ValidationState& state) {
+  return checkSignatureImpl(tx, state);
+}
+
+bool checkSignatures(Slice<const VbkTx* const> txes,
+                     std::vector<ValidationState>& states,
+                     ThreadPool* pool) {
+  return checkSignaturesImpl(txes, states, pool);
+}
+
+bool checkSignatures(Slice<const VbkPopTx* const> txes,
+                     std::vector<ValidationState>& states,
+                     ThreadPool* pool) {
+  return checkSignaturesImpl(txes, states, pool);
+}
+
+namespace {
+
+// payload kinds, mixed into StatelessValidationCache keys
+enum class CachedPayload : uint8_t { ATV = 1, VTB = 2 };
+
+// parts of a payload which are not committed to by its tx hash or id
+void writeUncommitted(WriteStream& stream,
+                      const std::vector<uint8_t>& signature,
+                      const std::vector<uint8_t>& publicKey,
+                      const VbkMerklePath& path) {
+  writeSingleByteLenValue(stream, signature);
+  writeSingleByteLenValue(stream, publicKey);
+  stream.writeBE<int32_t>(path.treeIndex);
+  stream.writeBE<int32_t>(path.index);
+  stream.write(path.subject);
+  for (const auto& layer : path.layers) {
+    stream.write(layer);
   }
-  return true;
 }
 
-bool checkATV(const ATV& atv,
-              ValidationState& state,
-              const AltChainParams& altp) {
-  if (atv.checked) {
-    // we've already checked that ATV
+// stateless validity of ATV depends on its content and altchain identifier.
+// ATV id commits to the tx and block of proof, but not to the signature and
+// merkle path, so they are mixed in. Neither the tx nor the payload is
+// serialized as a whole.
+uint256 getStatelessCacheKey(const ATV& atv, const AltChainParams& altp) {
+  const auto& tx = atv.transaction;
+  WriteStream stream(512);
+  stream.writeBE<uint8_t>((uint8_t)CachedPayload::ATV);
+  stream.writeBE<uint32_t>(atv.version);
+  stream.write(atv.getId());
+  writeUncommitted(stream, tx.signature, tx.publicKey, atv.merklePath);
+  stream.writeBE<int64_t>(altp.getIdentifier());
+  return sha256(stream.data());
+}
+
+// stateless validity of VTB depends on its content and BTC network. VTB id
+// does not commit to the whole VbkPopTx, so the tx hash is used instead.
+uint256 getStatelessCacheKey(const VTB& vtb, const BtcChainParams& btc) {
+  const auto& tx = vtb.transaction;
+  WriteStream stream(512);
+  stream.writeBE<uint8_t>((uint8_t)CachedPayload::VTB);
+  stream.writeBE<uint32_t>(vtb.version);
+  stream.write(tx.getHash());
+  stream.write(vtb.containingBlock.getHash());
+  writeUncommitted(stream, tx.signature, tx.publicKey, vtb.merklePath);
+  stream.write(btc.getPowLimit());
+  auto network = btc.networkName();
+  writeSingleByteLenValue(stream, network);
+  return sha256(stream.data());
+}
+
+// returns true if payload is known to be statelessly valid
+template <typename Payload, typename Params>
+bool isCachedAsValid(const Payload& p, const Params& params, uint256& key) {
+  if (p.checked) {
+    return true;
+  }
+
+  key = getStatelessCacheKey(p, params);
+  if (getStatelessValidationCache().contains(key)) {
+    p.checked = true;
     return true;
   }
 
+  return false;
+}
+
+template <typename Payload>
+void markAsValid(const Payload& p, const uint256& key) {
+  p.checked = true;
+  getStatelessValidationCache().insert(key);
+}
+
+bool checkATVIdentifier(const ATV& atv,
+                        ValidationState& state,
+                        const AltChainParams& altp) {
   auto id = atv.transaction.publicationData.identifier;
   auto eid = altp.getIdentifier();
   if (eid != id) {
@@ -321,19 +479,61 @@ bool checkATV(const ATV& atv,
                              std::to_string(eid) + ", got " +
                              std::to_string(id) + ".");
   }
+  return true;
+}
 
-  if (!checkVbkTx(atv.transaction, state)) {
-    return state.Invalid("vbk-check-tx");
-  }
-
+bool checkATVMerklePath(const ATV& atv, ValidationState& state) {
   if (!checkMerklePath(atv.merklePath,
                        atv.transaction.getHash(),
                        atv.blockOfProof.merkleRoot,
                        state)) {
     return state.Invalid("vbk-check-merkle-path");
   }
+  return true;
+}
+
+// everything checkVTB does, except for signature verification
+bool checkVTBWithoutSignature(const VTB& vtb,
+                              ValidationState& state,
+                              const BtcChainParams& btc) {
+  if (!checkVbkPopTxWithoutSignature(vtb.transaction, state, btc)) {
+    return state.Invalid("vbk-check-pop-tx");
+  }
 
-  atv.checked = true;
+  if (!checkMerklePath(vtb.merklePath,
+                       vtb.transaction.getHash(),
+                       vtb.containingBlock.merkleRoot,
+                       state)) {
+    return state.Invalid("vbk-check-merkle-path");
+  }
+
+  return true;
+}
+
+}  // namespace
+
+bool checkATV(const ATV& atv,
+              ValidationState& state,
+              const AltChainParams& altp) {
+  uint256 key;
+  if (isCachedAsValid(atv, altp, key)) {
+    // we've already checked that ATV
+    return true;
+  }
+
+  if (!checkATVIdentifier(atv, state, altp)) {
+    return false;
+  }
+
+  if (!checkVbkTx(atv.transaction, state)) {
+    return state.Invalid("vbk-check-tx");
+  }
+
+  if (!checkATVMerklePath(atv, state)) {
+    return false;
+  }
+
+  markAsValid(atv, key);
 
   return true;
 }
@@ -341,27 +541,111 @@ bool checkATV(const ATV& atv,
 bool checkVTB(const VTB& vtb,
               ValidationState& state,
               const BtcChainParams& btc) {
-  if (vtb.checked) {
+  uint256 key;
+  if (isCachedAsValid(vtb, btc, key)) {
     // we've already checked that VTB
     return true;
   }
 
-  if (!checkVbkPopTx(vtb.transaction, state, btc)) {
+  if (!checkSignature(vtb.transaction, state)) {
+    state.Invalid("vbk-check-signature");
     return state.Invalid("vbk-check-pop-tx");
   }
 
-  if (!checkMerklePath(vtb.merklePath,
-                       vtb.transaction.getHash(),
-                       vtb.containingBlock.merkleRoot,
-                       state)) {
-    return state.Invalid("vbk-check-merkle-path");
+  if (!checkVTBWithoutSignature(vtb, state, btc)) {
+    return false;
   }
 
-  vtb.checked = true;
+  markAsValid(vtb, key);
 
   return true;
 }
 
+bool checkATVs(const std::vector<ATV>& atvs,
+               std::vector<ValidationState>& states,
+               const AltChainParams& altp,
+               ThreadPool* pool) {
+  states.assign(atvs.size(), ValidationState());
+
+  // ATVs, which need signature verification
+  std::vector<size_t> unchecked;
+  std::vector<const VbkTx*> txes;
+  std::vector<uint256> keys(atvs.size());
+  for (size_t i = 0; i < atvs.size(); ++i) {
+    if (isCachedAsValid(atvs[i], altp, keys[i]) ||
+        !checkATVIdentifier(atvs[i], states[i], altp)) {
+      continue;
+    }
+    unchecked.push_back(i);
+    txes.push_back(&atvs[i].transaction);
+  }
+
+  std::vector<ValidationState> signatures;
+  checkSignatures(txes, signatures, pool);
+
+  parallelFor(pool, unchecked.size(), [&](size_t k) {
+    auto i = unchecked[k];
+    auto& state = states[i];
+    if (!signatures[k].IsValid()) {
+      state = signatures[k];
+      state.Invalid("vbk-check-signature");
+      state.Invalid("vbk-check-tx");
+      return;
+    }
+
+    if (checkATVMerklePath(atvs[i], state)) {
+      markAsValid(atvs[i], keys[i]);
+    }
+  });
+
+  return std::all_of(
+      states.begin(), states.end(), [](const ValidationState& state) {
+        return state.IsValid();
+      });
+}
+
+bool checkVTBs(const std::vector<VTB>& vtbs,
+               std::vector<ValidationState>& states,
+               const BtcChainParams& btc,
+               ThreadPool* pool) {
+  states.assign(vtbs.size(), ValidationState());
+
+  // VTBs, which need signature verification
+  std::vector<size_t> unchecked;
+  std::vector<const VbkPopTx*> txes;
+  std::vector<uint256> keys(vtbs.size());
+  for (size_t i = 0; i < vtbs.size(); ++i) {
+    if (isCachedAsValid(vtbs[i], btc, keys[i])) {
+      continue;
+    }
+    unchecked.push_back(i);
+    txes.push_back(&vtbs[i].transaction);
+  }
+
+  std::vector<ValidationState> signatures;
+  checkSignatures(txes, signatures, pool);
+
+  parallelFor(pool, unchecked.size(), [&](size_t k) {
+    auto i = unchecked[k];
+    auto& state = states[i];
+    if (!signatures[k].IsValid()) {
+      state = signatures[k];
+      state.Invalid("vbk-check-signature");
+      state.Invalid("vbk-check-pop-tx");
+      return;
+    }
+
+    if (checkVTBWithoutSignature(vtbs[i], state, btc)) {
+      markAsValid(vtbs[i], keys[i]);
+    }
+  });
+
+  return std::all_of(
+      states.begin(), states.end(), [](const ValidationState& state) {
+        return state.IsValid();
+      });
+}
+
 bool checkBlock(const VbkBlock& block,
                 ValidationState& state,
                 const VbkChainParams& params) {
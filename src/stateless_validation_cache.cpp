@@ -0,0 +1,54 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <veriblock/stateless_validation_cache.hpp>
+
+namespace altintegration {
+
+bool StatelessValidationCache::contains(const key_t& key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return keys_.count(key) > 0;
+}
+
+void StatelessValidationCache::insert(const key_t& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!keys_.insert(key).second) {
+    // already there
+    return;
+  }
+  order_.push_back(key);
+  truncate();
+}
+
+void StatelessValidationCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  keys_.clear();
+  order_.clear();
+}
+
+size_t StatelessValidationCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return keys_.size();
+}
+
+void StatelessValidationCache::setMaxSize(size_t maxSize) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  maxSize_ = maxSize;
+  truncate();
+}
+
+void StatelessValidationCache::truncate() {
+  while (order_.size() > maxSize_) {
+    keys_.erase(order_.front());
+    order_.pop_front();
+  }
+}
+
+StatelessValidationCache& getStatelessValidationCache() {
+  static StatelessValidationCache cache;
+  return cache;
+}
+
+}  // namespace altintegration
@@ -0,0 +1,156 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include "veriblock/storage/mmap/mapped_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <veriblock/storage/db_error.hpp>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace altintegration {
+
+namespace {
+
+[[noreturn]] void fail(const std::string& what, const std::string& path) {
+  throw db::StorageIOException(what + " " + path + ": " +
+                               std::strerror(errno));
+}
+
+}  // namespace
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(std::string path) : path_(std::move(path)) {
+  std::ifstream in(path_, std::ios::binary);
+  if (in) {
+    mirror_.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+  }
+  size_ = mapped_ = mirror_.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+void MappedFile::unmap() {}
+
+Slice<const uint8_t> MappedFile::read(size_t offset, size_t size) {
+  if (offset > size_ || size_ - offset < size) {
+    throw std::out_of_range("MappedFile::read(): out of data");
+  }
+  return {mirror_.data() + offset, size};
+}
+
+void MappedFile::write(size_t offset, const void* data, size_t size) {
+  if (offset + size > mirror_.size()) {
+    mirror_.resize(offset + size);
+  }
+  std::memcpy(mirror_.data() + offset, data, size);
+  size_ = mapped_ = mirror_.size();
+}
+
+void MappedFile::truncate(size_t size) {
+  mirror_.resize(size);
+  size_ = mapped_ = size;
+}
+
+void MappedFile::sync() {
+  std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+  out.write((const char*)mirror_.data(), (std::streamsize)mirror_.size());
+  if (!out) {
+    fail("can not write", path_);
+  }
+}
+
+#else
+
+MappedFile::MappedFile(std::string path) : path_(std::move(path)) {
+  fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd_ < 0) {
+    fail("can not open", path_);
+  }
+  struct stat st {};
+  if (::fstat(fd_, &st) != 0) {
+    ::close(fd_);
+    fail("can not stat", path_);
+  }
+  size_ = (size_t)st.st_size;
+}
+
+MappedFile::~MappedFile() {
+  unmap();
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+void MappedFile::unmap() {
+  if (map_ != nullptr) {
+    ::munmap(map_, mapped_);
+    map_ = nullptr;
+    mapped_ = 0;
+  }
+}
+
+Slice<const uint8_t> MappedFile::read(size_t offset, size_t size) {
+  if (offset > size_ || size_ - offset < size) {
+    throw std::out_of_range("MappedFile::read(): out of data");
+  }
+  if (offset + size > mapped_) {
+    // map whole file again, it has grown since the last mapping
+    unmap();
+    void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+      fail("can not map", path_);
+    }
+    map_ = (uint8_t*)p;
+    mapped_ = size_;
+  }
+  return {map_ + offset, size};
+}
+
+void MappedFile::write(size_t offset, const void* data, size_t size) {
+  const auto* p = (const uint8_t*)data;
+  size_t written = 0;
+  while (written < size) {
+    auto n = ::pwrite(fd_, p + written, size - written, (off_t)(offset + written));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail("can not write", path_);
+    }
+    written += (size_t)n;
+  }
+  if (offset + size > size_) {
+    size_ = offset + size;
+  }
+}
+
+void MappedFile::truncate(size_t size) {
+  unmap();
+  if (::ftruncate(fd_, (off_t)size) != 0) {
+    fail("can not truncate", path_);
+  }
+  size_ = size;
+}
+
+void MappedFile::sync() {
+  if (::fsync(fd_) != 0) {
+    fail("can not sync", path_);
+  }
+}
+
+#endif
+
+}  // namespace altintegration
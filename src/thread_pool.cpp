@@ -0,0 +1,142 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <veriblock/thread_pool.hpp>
+
+namespace altintegration {
+
+ThreadPool::ThreadPool(size_t threads) {
+  workers_.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (auto& w : workers_) {
+    w.join();
+  }
+}
+
+size_t ThreadPool::defaultConcurrency() {
+  auto n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        // stop_ is set and there is no more work
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    task();
+  }
+}
+
+std::future<void> ThreadPool::async(std::function<void()> f) {
+  auto task = std::make_shared<std::packaged_task<void()>>(std::move(f));
+  auto future = task->get_future();
+  if (workers_.empty()) {
+    (*task)();
+    return future;
+  }
+
+  enqueue([task]() { (*task)(); });
+  return future;
+}
+
+namespace {
+
+// state shared between all participants of a single parallelFor call
+struct ParallelForJob {
+  ParallelForJob(size_t n, const std::function<void(size_t)>& f)
+      : total(n), func(f) {}
+
+  const size_t total;
+  const std::function<void(size_t)>& func;
+  std::atomic<size_t> next{0};
+  size_t finished = 0;
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable done;
+
+  // grab indices until there is nothing left
+  void run() {
+    size_t executed = 0;
+    std::exception_ptr err;
+    for (size_t i = next++; i < total; i = next++) {
+      try {
+        func(i);
+      } catch (...) {
+        if (!err) {
+          err = std::current_exception();
+        }
+      }
+      ++executed;
+    }
+
+    if (executed == 0 && !err) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (err && !error) {
+      error = err;
+    }
+    finished += executed;
+    if (finished == total) {
+      done.notify_all();
+    }
+  }
+};
+
+}  // namespace
+
+void ThreadPool::parallelFor(size_t n, const std::function<void(size_t)>& f) {
+  if (n == 0) {
+    return;
+  }
+
+  auto job = std::make_shared<ParallelForJob>(n, f);
+  // do not wake up more workers than there is work for, caller participates
+  size_t helpers = std::min(workers_.size(), n - 1);
+  for (size_t i = 0; i < helpers; ++i) {
+    enqueue([job]() { job->run(); });
+  }
+
+  job->run();
+
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->done.wait(lock, [&job]() { return job->finished == job->total; });
+  if (job->error) {
+    std::rethrow_exception(job->error);
+  }
+}
+
+}  // namespace altintegration
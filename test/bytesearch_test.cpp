@@ -0,0 +1,79 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "veriblock/bytesearch.hpp"
+#include "veriblock/literals.hpp"
+
+using namespace altintegration;
+
+static size_t naiveFind(const std::vector<uint8_t>& h,
+                        const std::vector<uint8_t>& n,
+                        size_t from) {
+  if (from > h.size()) {
+    return h.size();
+  }
+  auto it = std::search(h.begin() + from, h.end(), n.begin(), n.end());
+  if (it == h.end() && !n.empty()) {
+    return h.size();
+  }
+  return it - h.begin();
+}
+
+TEST(BytesSearch, basic) {
+  auto h = "0011223344556677"_unhex;
+  auto n1 = "3344"_unhex;
+  auto n2 = "4433"_unhex;
+  auto n3 = "66"_unhex;
+  auto n4 = "001122334455667788"_unhex;
+  std::vector<uint8_t> empty;
+  EXPECT_EQ(findBytes(h, n1), 3u);
+  EXPECT_EQ(findBytes(h, n2), h.size());
+  EXPECT_EQ(findBytes(h, n3), 6u);
+  EXPECT_EQ(findBytes(h, n3, 7), h.size());
+  EXPECT_EQ(findBytes(h, n4), h.size());
+  EXPECT_EQ(findBytes(h, h), 0u);
+  EXPECT_EQ(findBytes(h, empty, 5), 5u);
+  EXPECT_EQ(findBytes(h, n1, 100), h.size());
+  EXPECT_TRUE(containsBytes(h, n1));
+  EXPECT_FALSE(containsBytes(h, n2));
+  EXPECT_FALSE(containsBytes(empty, n1));
+  EXPECT_TRUE(containsBytes(empty, empty));
+}
+
+TEST(BytesSearch, periodic_needle) {
+  auto h = "0101010102010101010101020101"_unhex;
+  auto n = "0101010102"_unhex;
+  EXPECT_EQ(findBytes(h, n), 0u);
+  EXPECT_EQ(findBytes(h, n, 1), 7u);
+  EXPECT_EQ(findBytes(h, n, 8), h.size());
+}
+
+// randomized comparison against std::search. Small alphabets produce lots of
+// partial matches and periodic needles, which exercise all branches.
+TEST(BytesSearch, matches_naive_search) {
+  std::mt19937 rng(0);
+  for (int alphabet : {2, 3, 256}) {
+    std::uniform_int_distribution<int> byte(0, alphabet - 1);
+    for (int iter = 0; iter < 3000; ++iter) {
+      std::vector<uint8_t> h(rng() % 200);
+      std::vector<uint8_t> n(rng() % 12);
+      for (auto& b : h) b = (uint8_t)byte(rng);
+      for (auto& b : n) b = (uint8_t)byte(rng);
+      // plant needle sometimes
+      if (!h.empty() && n.size() <= h.size() && rng() % 2) {
+        std::copy(n.begin(), n.end(), h.begin() + rng() % (h.size() - n.size() + 1));
+      }
+      size_t from = rng() % (h.size() + 2);
+      ASSERT_EQ(findBytes(h, n, from), naiveFind(h, n, from))
+          << "alphabet=" << alphabet << " iter=" << iter;
+    }
+  }
+}
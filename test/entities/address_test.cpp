@@ -47,6 +47,7 @@ TEST(Address, RoundTrip) {
   decoded.toVbkEncoding(outputStream);
   auto bytes = outputStream.data();
   EXPECT_EQ(bytes, ADDRESS_BYTES);
+  EXPECT_EQ(decoded.estimateSize(), bytes.size());
 }
 
 TEST(Address, ValidStandard) {
@@ -71,6 +72,11 @@ TEST(Address, DerivedFromPublicKey) {
   std::string addressString = "VFFDWUMLJwLRuNzH4NX8Rm32E59n6d";
   Address address = Address::fromString(addressString);
   EXPECT_TRUE(address.isDerivedFromPublicKey(publicKey));
+
+  auto derived = Address::fromPublicKey(publicKey);
+  WriteStream stream;
+  derived.toVbkEncoding(stream);
+  EXPECT_EQ(derived.estimateSize(), stream.data().size());
 }
 
 TEST(Address, NotDerivedFromPublicKey) {
@@ -109,4 +115,5 @@ TEST(Address, ParseMultisig) {
   EXPECT_EQ(decoded.toString(), addressString);
   EXPECT_EQ(decoded.getType(), AddressType::MULTISIG);
   EXPECT_FALSE(stream.hasMore(1)) << "stream has more data";
+  EXPECT_EQ(address.estimateSize(), bytes.size());
 }
@@ -86,6 +86,7 @@ TEST(ATV, RoundTrip) {
   auto txBytes = outputStream.data();
   auto txReEncoded = HexStr(txBytes);
   EXPECT_EQ(txReEncoded, defaultAtvEncoded);
+  EXPECT_EQ(decoded.estimateSize(), atvBytes.size());
 }
 
 TEST(ATV, getId_test) {
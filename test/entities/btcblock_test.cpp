@@ -59,6 +59,7 @@ TEST(BtcBlock, RoundTrip) {
   auto btcBytes = outputStream.data();
   auto blockReEncoded = HexStr(btcBytes);
   EXPECT_EQ(blockReEncoded, defaultBlockEncoded);
+  EXPECT_EQ(decoded.estimateRawSize(), btcBytes.size());
 }
 
 TEST(BtcBlock, getBlockHash_test) {
@@ -82,4 +82,5 @@ TEST(MerklePath, RoundTrip) {
   auto pathReEncoded = HexStr(pathBytes);
 
   EXPECT_EQ(pathReEncoded, defaultPathEncoded);
+  EXPECT_EQ(decoded.estimateSize(), pathBytes.size());
 }
@@ -27,4 +27,5 @@ TEST(AltPopTx, Deserialize) {
   PopData encodedPopData = PopData::fromVbkEncoding(bytes);
 
   EXPECT_EQ(encodedPopData, expectedPopData);
+  EXPECT_EQ(expectedPopData.estimateSize(), bytes.size());
 }
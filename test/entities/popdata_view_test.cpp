@@ -0,0 +1,128 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <gtest/gtest.h>
+
+#include <veriblock/entities/popdata_view.hpp>
+
+#include "util/test_utils.hpp"
+#include "veriblock/literals.hpp"
+
+using namespace altintegration;
+
+TEST(PopDataView, ATV) {
+  const auto bytes = ParseHex(defaultAtvEncoded);
+  ATV atv = ATV::fromVbkEncoding(bytes);
+  ATVView view = ATVView::fromVbkEncoding(bytes);
+
+  EXPECT_EQ(view.data().size(), bytes.size());
+  EXPECT_EQ(view.getTransactionHash(), atv.transaction.getHash());
+  EXPECT_EQ(view.getId(), atv.getId());
+  EXPECT_EQ(view.blockOfProof(), atv.blockOfProof);
+  EXPECT_EQ(view.merklePath().calculateMerkleRoot(),
+            atv.merklePath.calculateMerkleRoot());
+  WriteStream expected;
+  atv.merklePath.toVbkEncoding(expected);
+  WriteStream actual;
+  view.merklePath().toVbkMerklePath().toVbkEncoding(actual);
+  EXPECT_EQ(actual.data(), expected.data());
+  EXPECT_EQ(view.toATV().toVbkEncoding(), bytes);
+}
+
+TEST(PopDataView, VTB) {
+  const auto bytes = ParseHex(defaultVtbEncoded);
+  VTB vtb = VTB::fromVbkEncoding(bytes);
+  VTBView view = VTBView::fromVbkEncoding(bytes);
+
+  EXPECT_EQ(view.data().size(), bytes.size());
+  EXPECT_EQ(view.getTransactionHash(), vtb.transaction.getHash());
+  EXPECT_EQ(view.getId(), vtb.getId());
+  EXPECT_EQ(view.containingBlock(), vtb.containingBlock);
+  EXPECT_EQ(view.publishedBlock(), vtb.transaction.publishedBlock);
+  EXPECT_EQ(view.blockOfProof(), vtb.transaction.blockOfProof);
+  auto btctx = view.bitcoinTransaction();
+  EXPECT_EQ(std::vector<uint8_t>(btctx.begin(), btctx.end()),
+            vtb.transaction.bitcoinTransaction.tx);
+  EXPECT_EQ(view.merklePath().calculateMerkleRoot(),
+            vtb.merklePath.calculateMerkleRoot());
+  EXPECT_EQ(view.toVTB().toVbkEncoding(), bytes);
+}
+
+TEST(PopDataView, PopData) {
+  auto atvBytes = ParseHex(defaultAtvEncoded);
+  auto vtbBytes = ParseHex(defaultVtbEncoded);
+  ATV atv = ATV::fromVbkEncoding(atvBytes);
+  VTB vtb = VTB::fromVbkEncoding(vtbBytes);
+  PopData pd = {1, {vtb.containingBlock}, {vtb, vtb}, {atv}};
+  auto bytes = pd.toVbkEncoding();
+
+  PopDataView view = PopDataView::fromVbkEncoding(bytes);
+  ASSERT_EQ(view.context.size(), 1u);
+  ASSERT_EQ(view.vtbs.size(), 2u);
+  ASSERT_EQ(view.atvs.size(), 1u);
+  EXPECT_EQ(view.vtbs[1].getId(), vtb.getId());
+  EXPECT_EQ(view.atvs[0].getId(), atv.getId());
+  EXPECT_EQ(view.toPopData(), pd);
+}
+
+TEST(PopDataView, Truncated) {
+  auto bytes = ParseHex(defaultVtbEncoded);
+  bytes.resize(bytes.size() - 1);
+  EXPECT_THROW(VTBView::fromVbkEncoding(bytes), std::out_of_range);
+}
+
+namespace {
+
+// VBK encoding of `atv` with raw VbkTx replaced by `rawTx`
+std::vector<uint8_t> encodeWithRawTx(const ATV& atv,
+                                     const std::vector<uint8_t>& rawTx) {
+  WriteStream stream;
+  stream.writeBE<uint32_t>(atv.version);
+  writeVarLenValue(stream, rawTx);
+  writeSingleByteLenValue(stream, atv.transaction.signature);
+  writeSingleByteLenValue(stream, atv.transaction.publicKey);
+  atv.merklePath.toVbkEncoding(stream);
+  atv.blockOfProof.toVbkEncoding(stream);
+  return stream.data();
+}
+
+}  // namespace
+
+TEST(PopDataView, ATVInvalidTransaction) {
+  auto encoded = ParseHex(defaultAtvEncoded);
+  ATV atv = ATV::fromVbkEncoding(encoded);
+  WriteStream raw;
+  atv.transaction.toRaw(raw);
+  EXPECT_EQ(encodeWithRawTx(atv, raw.data()), atv.toVbkEncoding());
+
+  // address type follows optional network byte
+  WriteStream networkByte;
+  writeNetworkByte(networkByte, atv.transaction.networkOrType);
+  auto badAddress = raw.data();
+  badAddress.at(networkByte.data().size()) = 0xff;
+  auto bytes = encodeWithRawTx(atv, badAddress);
+  EXPECT_THROW(ATV::fromVbkEncoding(bytes), std::invalid_argument);
+  EXPECT_THROW(ATVView::fromVbkEncoding(bytes), std::invalid_argument);
+
+  // truncated publication data
+  auto truncated = raw.data();
+  truncated.pop_back();
+  bytes = encodeWithRawTx(atv, truncated);
+  EXPECT_THROW(ATV::fromVbkEncoding(bytes), std::out_of_range);
+  EXPECT_THROW(ATVView::fromVbkEncoding(bytes), std::out_of_range);
+
+  // trailing bytes would change tx hash
+  auto trailing = raw.data();
+  trailing.push_back(0);
+  bytes = encodeWithRawTx(atv, trailing);
+  EXPECT_THROW(ATVView::fromVbkEncoding(bytes), std::invalid_argument);
+}
+
+TEST(PopDataView, VTBStronglyEquivalencyId) {
+  const auto bytes = ParseHex(defaultVtbEncoded);
+  VTB vtb = VTB::fromVbkEncoding(bytes);
+  VTBView view = VTBView::fromVbkEncoding(bytes);
+  EXPECT_EQ(view.getStronglyEquivalencyId(), vtb.getStronglyEquivalencyId());
+}
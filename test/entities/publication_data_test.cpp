@@ -50,4 +50,5 @@ TEST(PublicationData, RoundTrip) {
   auto pubBytes = outputStream.data();
   auto pubReEncoded = HexStr(pubBytes);
   EXPECT_EQ(pubReEncoded, defaultPublicationEncoded);
+  EXPECT_EQ(decoded.estimateRawSize(), pubBytes.size());
 }
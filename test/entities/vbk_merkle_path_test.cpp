@@ -64,4 +64,5 @@ TEST(VbkMerklePath, RoundTrip) {
   auto pathReEncoded = HexStr(pathBytes);
 
   EXPECT_EQ(pathReEncoded, defaultPathEncoded);
+  EXPECT_EQ(decoded.estimateSize(), pathBytes.size());
 }
@@ -63,6 +63,7 @@ TEST(VbkBlock, RoundTrip) {
   auto vbkBytes = outputStream.data();
   auto blockReEncoded = HexStr(vbkBytes);
   EXPECT_EQ(blockReEncoded, defaultBlockEncoded);
+  EXPECT_EQ(decoded.estimateSize(), vbkBytes.size());
 }
 
 TEST(VbkBlock, getBlockHash_test) {
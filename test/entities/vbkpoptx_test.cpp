@@ -210,4 +210,5 @@ TEST(VbkPopTx, RoundTrip) {
   auto txBytes = outputStream.data();
   auto txReEncoded = HexStr(txBytes);
   EXPECT_EQ(txReEncoded, defaultTxEncoded);
+  EXPECT_EQ(decoded.estimateSize(), txBytes.size());
 }
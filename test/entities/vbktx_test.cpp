@@ -71,4 +71,5 @@ TEST(VbkTx, RoundTrip) {
   auto txBytes = outputStream.data();
   auto txReEncoded = HexStr(txBytes);
   EXPECT_EQ(txReEncoded, defaultTxEncoded);
+  EXPECT_EQ(decoded.estimateSize(), txBytes.size());
 }
@@ -195,6 +195,7 @@ TEST(VTB, RoundTrip) {
   auto txBytes = outputStream.data();
   auto txReEncoded = HexStr(txBytes);
   EXPECT_EQ(txReEncoded, defaultVtbEncoded);
+  EXPECT_EQ(decoded.estimateSize(), vtbBytes.size());
 }
 
 TEST(VTB, getId_test) {
@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
 #include <vector>
 
 #include "util/pop_test_fixture.hpp"
@@ -335,6 +337,278 @@ TEST_F(MemPoolFixture, removePayloads_test4) {
   ASSERT_TRUE(mempool->getMap<VbkBlock>().empty());
 }
 
+TEST_F(MemPoolFixture, removePayloads_evicts_expired_atv) {
+  mineAltBlocks(10, chain);
+  ASSERT_TRUE(alttree.setState(chain.rbegin()->getHash(), state));
+  // remember current tip, so that next calls process only changed payloads
+  mempool->removePayloads(PopData{});
+
+  auto* endorsed = alttree.getBlockIndex(chain[5].getHash());
+  ASSERT_NE(endorsed, nullptr);
+  VbkTx tx = popminer->createVbkTxEndorsingAltBlock(
+      generatePublicationData(chain[5]));
+  ATV atv = popminer->applyATV(tx, state);
+  ASSERT_TRUE(mempool->submit<ATV>(atv, state)) << state.toString();
+
+  int32_t window = altparam.getEndorsementSettlementInterval();
+  while (alttree.getBestChain().tip()->getHeight() + 1 <
+         endorsed->getHeight() + window) {
+    applyInNextBlock(PopData{});
+    mempool->removePayloads(PopData{});
+    ASSERT_EQ(mempool->getMap<ATV>().size(), 1);
+  }
+
+  applyInNextBlock(PopData{});
+  mempool->removePayloads(PopData{});
+  EXPECT_TRUE(mempool->getMap<ATV>().empty());
+  EXPECT_TRUE(checkedGetPop().atvs.empty());
+}
+
+TEST_F(MemPoolFixture, removePayloads_evicts_strongly_equivalent_vtbs) {
+  Miner<VbkBlock, VbkChainParams> vbk_miner(popminer->vbk().getParams());
+  auto* vbkTip = popminer->mineVbkBlocks(65);
+  mineAltBlocks(10, chain);
+
+  // the same VbkPopTx is contained in two different VBK blocks
+  const auto* endorsed = vbkTip->getAncestor(vbkTip->getHeight() - 10);
+  auto vbkPopTx = generatePopTx(endorsed->getHeader());
+  auto* containing1 = popminer->mineVbkBlocks(1);
+  ASSERT_EQ(popminer->vbkPayloads[containing1->getHash()].size(), 1);
+  VTB vtb1 = popminer->vbkPayloads[containing1->getHash()][0];
+
+  auto hashes = hashAll<VbkPopTx>({vbkPopTx});
+  VbkMerkleTree mtree(hashes, 0);
+  auto containing2 = vbk_miner.createNextBlock(
+      *popminer->vbk().getBestChain().tip(),
+      mtree.getMerkleRoot().trim<VBK_MERKLE_ROOT_HASH_SIZE>());
+  ASSERT_TRUE(popminer->vbk().acceptBlock(containing2, state));
+  VTB vtb2;
+  vtb2.transaction = vbkPopTx;
+  vtb2.merklePath.treeIndex = 0;
+  vtb2.merklePath.index = 0;
+  vtb2.merklePath.subject = hashes[0];
+  vtb2.merklePath.layers = mtree.getMerklePathLayers(hashes[0]);
+  vtb2.containingBlock = containing2;
+  ASSERT_EQ(vtb1.getStronglyEquivalencyId(), vtb2.getStronglyEquivalencyId());
+  ASSERT_NE(vtb1.getId(), vtb2.getId());
+
+  ASSERT_TRUE(alttree.setState(chain.rbegin()->getHash(), state));
+  // remember current tip, so that next call processes only changed payloads
+  mempool->removePayloads(PopData{});
+
+  PopData pop;
+  fillVbkContext(
+      pop.context, vbkparam.getGenesisBlock().getHash(), popminer->vbk());
+  for (const auto& b : pop.context) {
+    ASSERT_TRUE(mempool->submit<VbkBlock>(b, state)) << state.toString();
+  }
+  ASSERT_TRUE(mempool->submit<VTB>(vtb1, state)) << state.toString();
+  ASSERT_TRUE(mempool->submit<VTB>(vtb2, state)) << state.toString();
+  ASSERT_EQ(checkedGetPop().vtbs.size(), 2);
+
+  // connect vtb1 with context, which does not touch relation of vtb2
+  pop.context.erase(std::remove_if(pop.context.begin(),
+                                   pop.context.end(),
+                                   [&](const VbkBlock& b) {
+                                     return b.height >= containing2.height;
+                                   }),
+                    pop.context.end());
+  pop.vtbs = {vtb1};
+  applyInNextBlock(pop);
+  mempool->removePayloads(pop);
+
+  // only VBK block of vtb2 is left
+  EXPECT_EQ(mempool->getStats().bytes, containing2.toVbkEncoding().size());
+  EXPECT_TRUE(checkedGetPop().vtbs.empty());
+}
+
+TEST_F(MemPoolFixture, max_size_evicts_lowest_priority) {
+  popminer->mineVbkBlocks(10);
+  mineAltBlocks(10, chain);
+
+  // every ATV is contained in its own VBK block
+  std::vector<ATV> atvs;
+  for (int i = 0; i < 3; ++i) {
+    VbkTx tx = popminer->createVbkTxEndorsingAltBlock(
+        generatePublicationData(chain[5 + i]));
+    atvs.push_back(popminer->applyATV(tx, state));
+    ASSERT_TRUE(mempool->submit<ATV>(atvs.back(), state)) << state.toString();
+  }
+  ASSERT_EQ(mempool->getStats().evictedAtvs, 0);
+
+  auto bytes = mempool->getStats().bytes;
+  mempool->setMaxSize(bytes - 1);
+
+  // ATV in the oldest VBK block is evicted along with its VBK block
+  EXPECT_EQ(mempool->getStats().evictedAtvs, 1);
+  EXPECT_LT(mempool->getStats().bytes, bytes);
+  EXPECT_EQ(mempool->get<ATV>(atvs[0].getId()), nullptr);
+  EXPECT_NE(mempool->get<ATV>(atvs[1].getId()), nullptr);
+  EXPECT_NE(mempool->get<ATV>(atvs[2].getId()), nullptr);
+  EXPECT_EQ(mempool->getMap<VbkBlock>().count(atvs[0].blockOfProof.getId()),
+            0);
+
+  // it still has the lowest priority, and is rejected without touching
+  // mempool state
+  size_t acceptedVbkBlocks = 0;
+  mempool->onAccepted<VbkBlock>(
+      [&](const VbkBlock&) { ++acceptedVbkBlocks; });
+  auto before = mempool->getStats();
+  ValidationState submitState;
+  EXPECT_FALSE(mempool->submit<ATV>(atvs[0], submitState));
+  EXPECT_EQ(submitState.GetPath(), "pop-mempool-submit-atv-full");
+  EXPECT_EQ(mempool->getStats().evictedAtvs, before.evictedAtvs);
+  EXPECT_EQ(mempool->getStats().bytes, before.bytes);
+  EXPECT_EQ(acceptedVbkBlocks, 0);
+
+  mempool->clear();
+  EXPECT_EQ(mempool->getStats().bytes, 0);
+}
+
+TEST_F(MemPoolFixture, max_size_evicts_vbk_blocks) {
+  popminer->mineVbkBlocks(10);
+  std::vector<VbkBlock> context;
+  fillVbkContext(
+      context, vbkparam.getGenesisBlock().getHash(), popminer->vbk());
+  ASSERT_GE(context.size(), 10);
+
+  auto blockSize = context[0].toVbkEncoding().size();
+  mempool->setMaxSize(5 * blockSize);
+  for (const auto& b : context) {
+    ASSERT_TRUE(mempool->submit<VbkBlock>(b, state)) << state.toString();
+    ASSERT_LE(mempool->getStats().bytes, 5 * blockSize);
+  }
+
+  // the newest blocks are kept
+  EXPECT_EQ(mempool->getStats().evictedVbkBlocks, context.size() - 5);
+  EXPECT_EQ(mempool->getMap<VbkBlock>().size(), 5);
+  EXPECT_EQ(mempool->getMap<VbkBlock>().count(context.back().getId()), 1);
+  EXPECT_EQ(mempool->getMap<VbkBlock>().count(context.front().getId()), 0);
+
+  // older block does not fit
+  ValidationState submitState;
+  EXPECT_FALSE(mempool->submit<VbkBlock>(context.front(), submitState));
+  EXPECT_EQ(submitState.GetPath(), "pop-mempool-submit-vbk-full");
+}
+
+TEST_F(MemPoolFixture, concurrent_submit) {
+  popminer->mineVbkBlocks(10);
+  mineAltBlocks(10, chain);
+
+  std::vector<ATV> atvs;
+  for (int i = 0; i < 8; ++i) {
+    VbkTx tx = popminer->createVbkTxEndorsingAltBlock(
+        generatePublicationData(chain[1 + i]));
+    atvs.push_back(popminer->applyATV(tx, state));
+  }
+
+  std::atomic<size_t> accepted{0};
+  mempool->onAccepted<ATV>([&](const ATV&) { ++accepted; });
+
+  std::atomic<bool> done{false};
+  std::thread reader([&]() {
+    while (!done) {
+      auto snapshot = mempool->getSnapshot();
+      // every stored ATV has its VBK block in the same snapshot
+      for (const auto& p : *snapshot->atvs) {
+        ASSERT_EQ(snapshot->vbkblocks->count(p.second->blockOfProof.getId()),
+                  1);
+      }
+    }
+  });
+
+  std::vector<std::thread> writers;
+  for (size_t t = 0; t < 4; ++t) {
+    writers.emplace_back([&, t]() {
+      for (size_t i = t; i < atvs.size(); i += 4) {
+        ValidationState s;
+        EXPECT_TRUE(mempool->submit<ATV>(atvs[i], s)) << s.toString();
+      }
+    });
+  }
+  for (auto& w : writers) {
+    w.join();
+  }
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(accepted, atvs.size());
+  EXPECT_EQ(mempool->getMap<ATV>().size(), atvs.size());
+  for (const auto& atv : atvs) {
+    EXPECT_NE(mempool->get<ATV>(atv.getId()), nullptr);
+  }
+}
+
+TEST_F(MemPoolFixture, snapshot_is_immutable_and_shares_unchanged_maps) {
+  mineAltBlocks(10, chain);
+  ValidationState state;
+  VbkTx tx =
+      popminer->createVbkTxEndorsingAltBlock(generatePublicationData(chain[5]));
+  ATV atv = popminer->applyATV(tx, state);
+
+  auto before = mempool->getSnapshot();
+  auto atvs = mempool->getMap<ATV>();
+  ASSERT_TRUE(mempool->submit<ATV>(atv, state)) << state.toString();
+
+  // readers holding old snapshot see old state
+  EXPECT_TRUE(before->atvs->empty());
+  EXPECT_TRUE(before->vbkblocks->empty());
+  EXPECT_TRUE(atvs.empty());
+
+  auto after = mempool->getSnapshot();
+  EXPECT_EQ(after->atvs->size(), 1);
+  EXPECT_EQ(after->vbkblocks->size(), 1);
+  // VTBs did not change, so their map is shared
+  EXPECT_EQ(after->vtbs, before->vtbs);
+  // no modifications, no new snapshot
+  EXPECT_EQ(mempool->getSnapshot(), after);
+  EXPECT_EQ(&mempool->getMap<ATV>().get(), after->atvs.get());
+}
+
+TEST_F(MemPoolFixture, submitAll_encoded) {
+  auto* vbkTip = popminer->mineVbkBlocks(65);
+  const auto* endorsedVbkBlock = vbkTip->getAncestor(vbkTip->getHeight() - 10);
+  generatePopTx(endorsedVbkBlock->getHeader());
+  vbkTip = popminer->mineVbkBlocks(1);
+  auto& vtbs = popminer->vbkPayloads[vbkTip->getHash()];
+  ASSERT_EQ(vtbs.size(), 1);
+
+  mineAltBlocks(10, chain);
+  VbkTx tx =
+      popminer->createVbkTxEndorsingAltBlock(generatePublicationData(chain[5]));
+  ATV atv = popminer->applyATV(tx, state);
+
+  PopData pop;
+  fillVbkContext(
+      pop.context, vbkparam.getGenesisBlock().getHash(), popminer->vbk());
+  pop.vtbs = vtbs;
+  pop.atvs = {atv};
+  auto bytes = pop.toVbkEncoding();
+
+  auto r = mempool->submitAll(bytes);
+  ASSERT_EQ(r.vtbs.size(), 1);
+  ASSERT_EQ(r.atvs.size(), 1);
+  EXPECT_EQ(r.vtbs[0].first, vtbs[0].getId());
+  EXPECT_TRUE(r.vtbs[0].second.IsValid()) << r.vtbs[0].second.toString();
+  EXPECT_EQ(r.atvs[0].first, atv.getId());
+  EXPECT_TRUE(r.atvs[0].second.IsValid()) << r.atvs[0].second.toString();
+  EXPECT_EQ(mempool->getMap<VTB>().size(), 1);
+  EXPECT_EQ(mempool->getMap<ATV>().size(), 1);
+
+  // stored payloads are not submitted again, so no new snapshot for them
+  auto atvs = mempool->getSnapshot()->atvs;
+  auto again = mempool->submitAll(bytes);
+  ASSERT_EQ(again.atvs.size(), 1);
+  EXPECT_EQ(again.atvs[0].first, atv.getId());
+  EXPECT_TRUE(again.atvs[0].second.IsValid());
+  ASSERT_EQ(again.vtbs.size(), 1);
+  EXPECT_TRUE(again.vtbs[0].second.IsValid());
+  EXPECT_EQ(mempool->getSnapshot()->atvs, atvs);
+
+  bytes.pop_back();
+  EXPECT_THROW(mempool->submitAll(bytes), std::out_of_range);
+}
+
 TEST_F(MemPoolFixture, removed_payloads_cache_test) {
   // mine 65 VBK blocks
   auto* vbkTip = popminer->mineVbkBlocks(65);
@@ -440,7 +714,61 @@ TEST_F(MemPoolFixture, submit_vbk_blocks) {
   }
 
   EXPECT_FALSE(mempool->submit<VbkBlock>(context.back(), state));
-  EXPECT_EQ(state.GetPath(), "pop-mempool-submit-vbk-stateful+bad-prev");
+  EXPECT_EQ(state.GetPath(), "pop-mempool-submit-vbk-orphan+bad-prev");
+  EXPECT_EQ(mempool->getStats().orphans, 1);
+  EXPECT_EQ(mempool->getMap<VbkBlock>().count(context.back().getId()), 0);
+
+  // missing block arrives, orphan is admitted
+  auto* missing = popminer->vbk().getBlockIndex(context.back().previousBlock);
+  ASSERT_NE(missing, nullptr);
+  ValidationState state2;
+  ASSERT_TRUE(mempool->submit<VbkBlock>(missing->getHeader(), state2))
+      << state2.toString();
+  EXPECT_EQ(mempool->getStats().orphans, 0);
+  EXPECT_EQ(mempool->getMap<VbkBlock>().count(context.back().getId()), 1);
+}
+
+TEST_F(MemPoolFixture, submit_orphan_vtb) {
+  auto* vbkTip = popminer->mineVbkBlocks(65);
+  auto endorsed1 = vbkTip->getAncestor(vbkTip->getHeight() - 10)->getHeader();
+  auto endorsed2 = vbkTip->getAncestor(vbkTip->getHeight() - 11)->getHeader();
+
+  // BTC context of the second VTB starts after block of proof of the first
+  auto btctx1 = popminer->createBtcTxEndorsingVbkBlock(endorsed1);
+  auto* blockOfProof1 = popminer->mineBtcBlocks(1);
+  popminer->createVbkPopTxEndorsingVbkBlock(blockOfProof1->getHeader(),
+                                            btctx1,
+                                            endorsed1,
+                                            getLastKnownBtcBlock());
+  popminer->mineBtcBlocks(10);
+  auto btctx2 = popminer->createBtcTxEndorsingVbkBlock(endorsed2);
+  auto* blockOfProof2 = popminer->mineBtcBlocks(1);
+  popminer->createVbkPopTxEndorsingVbkBlock(blockOfProof2->getHeader(),
+                                            btctx2,
+                                            endorsed2,
+                                            blockOfProof1->getHash());
+  vbkTip = popminer->mineVbkBlocks(1);
+
+  auto& vtbs = popminer->vbkPayloads[vbkTip->getHash()];
+  ASSERT_EQ(vtbs.size(), 2);
+  const VTB* first = &vtbs[0];
+  const VTB* second = &vtbs[1];
+  if (first->transaction.blockOfProof != blockOfProof1->getHeader()) {
+    std::swap(first, second);
+  }
+
+  EXPECT_FALSE(mempool->submit<VTB>(*second, state));
+  EXPECT_EQ(state.GetPath(), "pop-mempool-submit-vtb-orphan");
+  EXPECT_EQ(mempool->getStats().orphans, 1);
+  EXPECT_TRUE(mempool->getMap<VTB>().empty());
+
+  size_t accepted = 0;
+  mempool->onAccepted<VTB>([&](const VTB&) { ++accepted; });
+  ValidationState state2;
+  ASSERT_TRUE(mempool->submit<VTB>(*first, state2)) << state2.toString();
+  EXPECT_EQ(mempool->getStats().orphans, 0);
+  EXPECT_EQ(mempool->getMap<VTB>().size(), 2);
+  EXPECT_EQ(accepted, 2);
 }
 
 TEST_F(MemPoolFixture, submit_deprecated_payloads) {
@@ -1089,10 +1417,11 @@ TEST_F(MemPoolFixture, getPop_scenario_10) {
   };
   // PopData with 1 VBK block is 71 bytes
   const auto popDataWith1VBK = estimatePopDataWithVbkSize();
+  const auto vbkBlockSize = VbkBlock().toVbkEncoding().size();
   const auto max = alttree.getParams().getMaxPopDataSize();
 
   Miner<VbkBlock, VbkChainParams> vbk_miner(popminer->vbk().getParams());
-  popminer->mineVbkBlocks(max / popDataWith1VBK + 10);
+  popminer->mineVbkBlocks(max / vbkBlockSize + 10);
   mineAltBlocks(10, chain);
   AltBlock endorsedBlock1 = chain[5];
 
@@ -1115,7 +1444,9 @@ TEST_F(MemPoolFixture, getPop_scenario_10) {
   {
     PopData v_popData = checkedGetPop();
     ASSERT_LE(v_popData.estimateSize(), max);
-    ASSERT_EQ(v_popData.context.size(), max / popDataWith1VBK);
+    // no more VBK blocks fit
+    ASSERT_GT(v_popData.estimateSize() + vbkBlockSize, max);
+    ASSERT_GE(v_popData.context.size(), max / popDataWith1VBK);
     ASSERT_EQ(v_popData.vtbs.size(), 0);
     ASSERT_EQ(v_popData.atvs.size(), 0);
   }
@@ -1123,7 +1454,9 @@ TEST_F(MemPoolFixture, getPop_scenario_10) {
     // second getPop should return same data
     PopData v_popData = checkedGetPop();
     ASSERT_LE(v_popData.estimateSize(), max);
-    ASSERT_EQ(v_popData.context.size(), max / popDataWith1VBK);
+    // no more VBK blocks fit
+    ASSERT_GT(v_popData.estimateSize() + vbkBlockSize, max);
+    ASSERT_GE(v_popData.context.size(), max / popDataWith1VBK);
     ASSERT_EQ(v_popData.vtbs.size(), 0);
     ASSERT_EQ(v_popData.atvs.size(), 0);
     // lets remove it
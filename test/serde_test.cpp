@@ -26,4 +26,48 @@ TEST(Serde, ToFromArrayRoundTrip) {
   });
 
   ASSERT_EQ(v, actual);
-}
\ No newline at end of file
+}
+TEST(Serde, ReadString) {
+  WriteStream w;
+  writeSingleBEValue(w, 5);
+  w.write(std::string("hello"));
+  writeSingleBEValue(w, 0);
+  writeSingleBEValue(w, 10);
+  w.write(std::string("short"));
+
+  ReadStream r(w.data());
+  EXPECT_EQ(readString(r), "hello");
+  EXPECT_EQ(readString(r), "");
+  EXPECT_THROW(readString(r), std::out_of_range);
+}
+
+TEST(Serde, VarIntRoundTrip) {
+  const std::vector<uint64_t> values{
+      0, 1, 127, 128, 300, 16383, 16384, 0xffffffff, (uint64_t)-1};
+
+  WriteStream w;
+  size_t expectedSize = 0;
+  for (auto v : values) {
+    writeVarInt(w, v);
+    expectedSize += varIntSize(v);
+  }
+  ASSERT_EQ(w.data().size(), expectedSize);
+  EXPECT_EQ(varIntSize(127), 1);
+  EXPECT_EQ(varIntSize(128), 2);
+  EXPECT_EQ(varIntSize((uint64_t)-1), 10);
+
+  ReadStream r(w.data());
+  for (auto v : values) {
+    EXPECT_EQ(readVarInt(r), v);
+  }
+  EXPECT_FALSE(r.hasMore(1));
+
+  // truncated and overlong encodings
+  std::vector<uint8_t> truncated{0x80, 0x80};
+  ReadStream r1(truncated);
+  EXPECT_THROW(readVarInt(r1), std::out_of_range);
+  std::vector<uint8_t> overflow(10, 0xff);
+  overflow.push_back(0x01);
+  ReadStream r2(overflow);
+  EXPECT_THROW(readVarInt(r2), std::out_of_range);
+}
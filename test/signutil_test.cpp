@@ -56,3 +56,25 @@ TEST(SIGN_UTIL, Invalid) {
   EXPECT_THROW(altintegration::veriBlockVerify(dummy, dummy, dummy),
                std::invalid_argument);
 }
+
+TEST(SIGN_UTIL, VerifyParsedKey) {
+  ParsedPublicKey key;
+  ASSERT_TRUE(parsePublicKeyVbk(defaultPublicKeyVbk, key));
+  EXPECT_EQ(veriBlockVerify(defaultMsg, defaultSignatureVbk, key), 1);
+
+  // second parse is served from cache and gives the same key
+  ParsedPublicKey cached;
+  ASSERT_TRUE(parsePublicKeyVbk(defaultPublicKeyVbk, cached));
+  EXPECT_TRUE(std::equal(
+      std::begin(key.data), std::end(key.data), std::begin(cached.data)));
+
+  auto otherMsg = "Hello world!"_v;
+  EXPECT_EQ(veriBlockVerify(otherMsg, defaultSignatureVbk, key), 0);
+}
+
+TEST(SIGN_UTIL, ParseInvalidKey) {
+  ParsedPublicKey key;
+  auto malformed = defaultPublicKeyVbk;
+  malformed.pop_back();
+  EXPECT_FALSE(parsePublicKeyVbk(malformed, key));
+}
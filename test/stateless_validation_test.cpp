@@ -5,12 +5,16 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "util/alt_chain_params_regtest.hpp"
 #include "util/test_utils.hpp"
+#include "veriblock/altintegration.hpp"
 #include "veriblock/blockchain/btc_chain_params.hpp"
 #include "veriblock/blockchain/vbk_chain_params.hpp"
 #include "veriblock/literals.hpp"
 #include "veriblock/stateless_validation.hpp"
+#include "veriblock/storage/inmem/repository_inmem.hpp"
 
 using namespace altintegration;
 
@@ -372,3 +376,251 @@ TEST_F(StatelessValidationTest, containsSplit_when_chunked) {
       "00000767000193093228BD2B4906F6B84BE5E61809C0522626145DDFB988022A0684E2110D384FE2BFD38549CB19C41893C258BA5B9CAB24060BA2D41039DFC857801424B0F5DE63992A016F5F38FEB4"_unhex,
       buffer.data()));
 }
+
+TEST_F(StatelessValidationTest, containsSplit_truncated_descriptor) {
+  // magic and descriptor of 4 chunks, but chunk descriptors are cut off
+  auto tx = "0000927A5946245000"_unhex;
+  auto pop = "00000767"_unhex;
+  ASSERT_FALSE(containsSplit(pop, tx));
+}
+
+TEST_F(StatelessValidationTest, containsSplit_random_data) {
+  std::mt19937 rng(0);
+  auto pop = generateRandomBytesVector(80);
+  for (int iter = 0; iter < 2000; ++iter) {
+    std::vector<uint8_t> tx(rng() % 300);
+    for (auto& b : tx) {
+      b = (uint8_t)rng();
+    }
+    // sprinkle magic bytes to reach descriptor parsing
+    for (int m = 0; m < 5 && tx.size() >= 4; ++m) {
+      size_t at = rng() % (tx.size() - 3);
+      tx[at] = 0x92;
+      tx[at + 1] = 0x7a;
+      tx[at + 2] = 0x59;
+    }
+    ASSERT_FALSE(containsSplit(pop, tx));
+  }
+}
+
+TEST_F(StatelessValidationTest,
+       checkBitcoinTransactionForPoPData_not_contiguous_invalid) {
+  VbkPopTx tx = validPopTx;
+  WriteStream stream;
+  tx.publishedBlock.toRaw(stream);
+  tx.address.getPopBytes(stream);
+  const auto& pop = stream.data();
+
+  // all publication bytes in order, but with a gap in between
+  std::vector<uint8_t> btctx(pop.begin(), pop.begin() + 10);
+  btctx.push_back(0xff);
+  btctx.insert(btctx.end(), pop.begin() + 10, pop.end());
+  tx.bitcoinTransaction.tx = btctx;
+  ASSERT_FALSE(checkBitcoinTransactionForPoPData(tx, state));
+
+  // tx shorter than publication data
+  tx.bitcoinTransaction.tx = std::vector<uint8_t>(pop.begin(), pop.begin() + 5);
+  ASSERT_FALSE(checkBitcoinTransactionForPoPData(tx, state));
+
+  btctx.erase(btctx.begin() + 10);
+  tx.bitcoinTransaction.tx = btctx;
+  ASSERT_TRUE(checkBitcoinTransactionForPoPData(tx, state));
+}
+
+TEST_F(StatelessValidationTest, checkSignatures_batch) {
+  VbkTx invalid = validVbkTx;
+  invalid.signature[10] ^= 0x01;
+  std::vector<const VbkTx*> txes{&validVbkTx, &invalid, &validVbkTx};
+  std::vector<ValidationState> states;
+
+  ThreadPool pool(2);
+  ASSERT_FALSE(checkSignatures(txes, states, &pool));
+  ASSERT_EQ(states.size(), txes.size());
+  EXPECT_TRUE(states[0].IsValid());
+  EXPECT_FALSE(states[1].IsValid());
+  EXPECT_EQ(states[1].GetPath(), "invalid-vbk-tx");
+  EXPECT_TRUE(states[2].IsValid());
+
+  std::vector<const VbkPopTx*> poptxes{&validPopTx, &validPopTx};
+  ASSERT_TRUE(checkSignatures(poptxes, states));
+  ASSERT_EQ(states.size(), poptxes.size());
+}
+
+TEST_F(StatelessValidationTest, checkATVs_matches_checkATV) {
+  AltChainParamsRegTest altp;
+  ATV badMerklePath = validATV;
+  badMerklePath.blockOfProof.merkleRoot =
+      uint128("0356EB39B851682679F9A0131A4E4A5F"_unhex);
+  ATV badSignature = validATV;
+  badSignature.transaction.signature[10] ^= 0x01;
+  std::vector<ATV> atvs{validATV, badMerklePath, badSignature};
+  for (auto& atv : atvs) {
+    atv.checked = false;
+  }
+
+  ThreadPool pool(2);
+  std::vector<ValidationState> states;
+  ASSERT_FALSE(checkATVs(atvs, states, altp, &pool));
+  ASSERT_EQ(states.size(), atvs.size());
+  for (size_t i = 0; i < atvs.size(); ++i) {
+    ATV copy = atvs[i];
+    copy.checked = false;
+    ValidationState expected;
+    checkATV(copy, expected, altp);
+    EXPECT_EQ(states[i].GetPath(), expected.GetPath());
+    EXPECT_EQ(atvs[i].checked, expected.IsValid());
+  }
+}
+
+TEST_F(StatelessValidationTest, checkVTBs_matches_checkVTB) {
+  VTB badMerklePath = validVTB;
+  badMerklePath.containingBlock.merkleRoot =
+      uint128("0356EB39B851682679F9A0131A4E4A5F"_unhex);
+  VTB badSignature = validVTB;
+  badSignature.transaction.signature[10] ^= 0x01;
+  std::vector<VTB> vtbs{validVTB, badMerklePath, badSignature};
+  for (auto& vtb : vtbs) {
+    vtb.checked = false;
+  }
+
+  ThreadPool pool(2);
+  std::vector<ValidationState> states;
+  ASSERT_FALSE(checkVTBs(vtbs, states, btc, &pool));
+  ASSERT_EQ(states.size(), vtbs.size());
+  for (size_t i = 0; i < vtbs.size(); ++i) {
+    VTB copy = vtbs[i];
+    copy.checked = false;
+    ValidationState expected;
+    checkVTB(copy, expected, btc);
+    EXPECT_EQ(states[i].GetPath(), expected.GetPath());
+    EXPECT_EQ(vtbs[i].checked, expected.IsValid());
+  }
+}
+
+TEST_F(StatelessValidationTest, Altintegration_checkPopData_parallel) {
+  auto config = std::make_shared<Config>();
+  config->alt = std::make_shared<AltChainParamsRegTest>();
+  config->btc.params = std::make_shared<BtcChainParamsRegTest>();
+  config->vbk.params = std::make_shared<VbkChainParamsRegTest>();
+  config->statelessValidationThreads = 2;
+  std::shared_ptr<Repository> repo = std::make_shared<RepositoryInmem>();
+  auto service = Altintegration::create(config, repo);
+  ASSERT_NE(service->pool, nullptr);
+  ASSERT_EQ(service->pool->size(), 2u);
+
+  VTB badSignature = validVTB;
+  badSignature.transaction.signature[10] ^= 0x01;
+  PopData pop;
+  pop.vtbs = {validVTB, badSignature, validVTB};
+  pop.atvs = {validATV};
+  for (auto& vtb : pop.vtbs) {
+    vtb.checked = false;
+  }
+  pop.atvs[0].checked = false;
+
+  std::vector<ValidationState> vtbStates;
+  std::vector<ValidationState> atvStates;
+  ASSERT_FALSE(service->checkPopData(pop, state, vtbStates, atvStates));
+  ASSERT_EQ(vtbStates.size(), 3u);
+  EXPECT_TRUE(vtbStates[0].IsValid());
+  EXPECT_FALSE(vtbStates[1].IsValid());
+  EXPECT_TRUE(vtbStates[2].IsValid());
+  // ATVs are not checked once a VTB is invalid
+  EXPECT_TRUE(atvStates.empty());
+  EXPECT_FALSE(pop.atvs[0].checked);
+  EXPECT_EQ(state.GetPathParts().front(), "pop-vtb-statelessly-invalid");
+
+  // nor are VTBs, if context is invalid
+  PopData badContext = pop;
+  badContext.context.push_back(validVTB.containingBlock);
+  badContext.context.back().nonce ^= 1;
+  for (auto& vtb : badContext.vtbs) {
+    vtb.checked = false;
+  }
+  vtbStates.clear();
+  ValidationState contextState;
+  ASSERT_FALSE(
+      service->checkPopData(badContext, contextState, vtbStates, atvStates));
+  EXPECT_EQ(contextState.GetPathParts().front(),
+            "pop-vbkblock-statelessly-invalid");
+  EXPECT_TRUE(vtbStates.empty());
+
+  pop.vtbs.erase(pop.vtbs.begin() + 1);
+  ValidationState valid;
+  ASSERT_TRUE(service->checkPopData(pop, valid)) << valid.toString();
+}
+
+TEST(StatelessValidationCache, evicts_oldest) {
+  StatelessValidationCache cache(2);
+  uint256 a(std::vector<uint8_t>(32, 1));
+  uint256 b(std::vector<uint8_t>(32, 2));
+  uint256 c(std::vector<uint8_t>(32, 3));
+  cache.insert(a);
+  cache.insert(b);
+  cache.insert(b);
+  ASSERT_EQ(cache.size(), 2);
+  cache.insert(c);
+  ASSERT_EQ(cache.size(), 2);
+  EXPECT_FALSE(cache.contains(a));
+  EXPECT_TRUE(cache.contains(b));
+  EXPECT_TRUE(cache.contains(c));
+
+  cache.setMaxSize(1);
+  EXPECT_FALSE(cache.contains(b));
+  EXPECT_TRUE(cache.contains(c));
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(StatelessValidationTest, ATV_copies_are_served_from_cache) {
+  AltChainParamsRegTest altp;
+  ATV atv = validATV;
+  atv.checked = false;
+  ASSERT_TRUE(checkATV(atv, state, altp));
+
+  // a fresh copy (e.g. deserialized one) does not carry `checked` flag
+  auto encoded = atv.toVbkEncoding();
+  ATV copy = ATV::fromVbkEncoding(encoded);
+  ASSERT_FALSE(copy.checked);
+  ASSERT_TRUE(checkATV(copy, state, altp));
+  ASSERT_TRUE(copy.checked);
+
+  // cached validity does not leak to other altchains
+  AltChainParamsRegTest other;
+  other.id = 0x1337;
+  ATV another = ATV::fromVbkEncoding(encoded);
+  ASSERT_FALSE(checkATV(another, state, other));
+  ASSERT_EQ(state.GetPath(), "atv-bad-identifier");
+}
+
+TEST_F(StatelessValidationTest, cache_does_not_hide_bad_signature) {
+  VTB vtb = validVTB;
+  vtb.checked = false;
+  ASSERT_TRUE(checkVTB(vtb, state, btc));
+
+  // same id, but different signature
+  VTB tampered = validVTB;
+  tampered.checked = false;
+  tampered.transaction.signature[10] ^= 0x01;
+  ASSERT_EQ(tampered.getId(), vtb.getId());
+  ASSERT_FALSE(checkVTB(tampered, state, btc));
+
+  // same id, but different merkle path
+  VTB badPath = validVTB;
+  badPath.checked = false;
+  ASSERT_FALSE(badPath.merklePath.layers.empty());
+  badPath.merklePath.layers[0].data()[0] ^= 0x01;
+  ASSERT_EQ(badPath.getId(), vtb.getId());
+  ASSERT_FALSE(checkVTB(badPath, state, btc));
+
+  AltChainParamsRegTest altp;
+  ATV atv = validATV;
+  atv.checked = false;
+  ASSERT_TRUE(checkATV(atv, state, altp));
+  ATV tamperedAtv = validATV;
+  tamperedAtv.checked = false;
+  tamperedAtv.transaction.signature[10] ^= 0x01;
+  ASSERT_EQ(tamperedAtv.getId(), atv.getId());
+  ASSERT_FALSE(checkATV(tamperedAtv, state, altp));
+}
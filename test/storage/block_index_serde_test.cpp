@@ -0,0 +1,150 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <util/pop_test_fixture.hpp>
+
+using namespace altintegration;
+
+template <typename E>
+std::vector<E> sortedEndorsements(const PopState<E>& state) {
+  std::vector<E> ret;
+  for (const auto& pair : state.getContainingEndorsements()) {
+    ret.push_back(*pair.second);
+  }
+  std::sort(ret.begin(), ret.end());
+  return ret;
+}
+
+void expectAddonEq(const BlockIndex<BtcBlock>& a,
+                   const BlockIndex<BtcBlock>& b) {
+  EXPECT_EQ(a.getRefs(), b.getRefs());
+}
+
+void expectAddonEq(const BlockIndex<VbkBlock>& a,
+                   const BlockIndex<VbkBlock>& b) {
+  EXPECT_EQ(a.refCount(), b.refCount());
+  EXPECT_EQ(a.getPayloadIds<VTB>(), b.getPayloadIds<VTB>());
+  EXPECT_EQ(sortedEndorsements(a), sortedEndorsements(b));
+}
+
+void expectAddonEq(const BlockIndex<AltBlock>& a,
+                   const BlockIndex<AltBlock>& b) {
+  EXPECT_EQ(a.getPayloadIds<ATV>(), b.getPayloadIds<ATV>());
+  EXPECT_EQ(a.getPayloadIds<VTB>(), b.getPayloadIds<VTB>());
+  EXPECT_EQ(a.getPayloadIds<VbkBlock>(), b.getPayloadIds<VbkBlock>());
+  EXPECT_EQ(sortedEndorsements(a), sortedEndorsements(b));
+}
+
+template <typename Block>
+void expectIndexEq(const BlockIndex<Block>& a, const BlockIndex<Block>& b) {
+  EXPECT_EQ(a.getHeight(), b.getHeight());
+  EXPECT_EQ(a.getHeader(), b.getHeader());
+  EXPECT_EQ(a.getStatus(), b.getStatus());
+  expectAddonEq(a, b);
+}
+
+struct BlockIndexSerdeTest : public PopTestFixture, public testing::Test {
+  BlockIndexSerdeTest() { createEndorsedAltChain(20, 3); }
+
+  // returns {compact size, legacy size} of all blocks in the tree
+  template <typename Tree>
+  std::pair<size_t, size_t> checkTree(const Tree& tree) {
+    using index_t = typename Tree::index_t;
+    using block_t = typename index_t::block_t;
+    size_t compactSize = 0;
+    size_t legacySize = 0;
+    for (const auto& pair : tree.getBlocks()) {
+      const auto& index = *pair.second;
+      auto compact = index.toRaw();
+      WriteStream legacyStream;
+      index.toLegacyRaw(legacyStream);
+      auto legacy = legacyStream.data();
+      compactSize += compact.size();
+      legacySize += legacy.size();
+
+      EXPECT_EQ(compact.at(0), index_t::COMPACT_ENCODING_MARKER);
+      EXPECT_EQ(compact.at(1), index_t::COMPACT_ENCODING_VERSION);
+      ReadStream headerStream(
+          compact.data() + index_t::COMPACT_ENCODING_HEADER_OFFSET,
+          compact.size() - index_t::COMPACT_ENCODING_HEADER_OFFSET);
+      EXPECT_EQ(block_t::fromRaw(headerStream), index.getHeader());
+
+      auto decoded = index_t::fromRaw(compact);
+      expectIndexEq(index, decoded);
+      EXPECT_FALSE(decoded.isDirty());
+      EXPECT_EQ(decoded.toRaw(), compact);
+
+      // legacy encoding is still readable and is marked for migration
+      auto migrated = index_t::fromRaw(legacy);
+      expectIndexEq(index, migrated);
+      EXPECT_TRUE(migrated.isDirty());
+      EXPECT_EQ(migrated.toRaw(), compact);
+    }
+    return {compactSize, legacySize};
+  }
+};
+
+TEST_F(BlockIndexSerdeTest, RoundTrip) {
+  checkTree(alttree.btc());
+  auto vbk = checkTree(alttree.vbk());
+  auto alt = checkTree(alttree);
+
+  // endorsements are stored by reference, so blocks shrink
+  EXPECT_LT(vbk.first, vbk.second);
+  EXPECT_LT(alt.first, alt.second);
+}
+
+TEST_F(BlockIndexSerdeTest, ExplicitEndorsementFields) {
+  auto index = *alttree.vbk().getBestChain().tip();
+  auto e = std::make_shared<VbkEndorsement>();
+  // id is not among payload ids, containing hash is not the block hash
+  e->id = uint256::fromHex("01");
+  e->containingHash = uint192::fromHex("02");
+  e->endorsedHash = index.getHash();
+  e->blockOfProof = uint256::fromHex("03");
+  index.insertContainingEndorsement(e);
+
+  auto bytes = index.toRaw();
+  auto decoded = BlockIndex<VbkBlock>::fromRaw(bytes);
+  expectIndexEq(index, decoded);
+}
+
+TEST_F(BlockIndexSerdeTest, UnknownVersion) {
+  auto bytes = alttree.btc().getBestChain().tip()->toRaw();
+  bytes.at(1) = BlockIndex<BtcBlock>::COMPACT_ENCODING_VERSION + 1;
+  EXPECT_THROW(BlockIndex<BtcBlock>::fromRaw(bytes), std::out_of_range);
+}
+
+TEST_F(BlockIndexSerdeTest, LegacyBlockStaysDirtyAfterLoad) {
+  auto* tip = alttree.getBestChain().tip();
+  auto makeNext = [&](const BlockIndex<AltBlock>& prev) {
+    BlockIndex<AltBlock> index;
+    index.setHeader(generateNextBlock(prev.getHeader()));
+    index.setHeight(prev.getHeight() + 1);
+    return index;
+  };
+
+  // block stored in the legacy encoding is rewritten on the next save
+  auto legacyBlock = makeNext(*tip);
+  WriteStream legacy;
+  legacyBlock.toLegacyRaw(legacy);
+  ASSERT_TRUE(alttree.loadBlock(
+      BlockIndex<AltBlock>::fromRaw(legacy.data()), state));
+  auto* loaded = alttree.getBlockIndex(legacyBlock.getHash());
+  ASSERT_TRUE(loaded);
+  EXPECT_TRUE(loaded->isDirty());
+
+  // block stored in the compact encoding is not
+  auto compactBlock = makeNext(*loaded);
+  auto compact = compactBlock.toRaw();
+  ASSERT_TRUE(
+      alttree.loadBlock(BlockIndex<AltBlock>::fromRaw(compact), state));
+  loaded = alttree.getBlockIndex(compactBlock.getHash());
+  ASSERT_TRUE(loaded);
+  EXPECT_FALSE(loaded->isDirty());
+}
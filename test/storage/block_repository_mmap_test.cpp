@@ -0,0 +1,205 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <util/pop_test_fixture.hpp>
+#include <veriblock/storage/inmem/pop_storage_inmem.hpp>
+#include <veriblock/storage/mmap/block_repository_mmap.hpp>
+#include <veriblock/storage/pop_storage_batch_adaptor.hpp>
+
+using namespace altintegration;
+
+using btc_repo_t = BlockRepositoryMmap<BlockIndex<BtcBlock>>;
+using vbk_repo_t = BlockRepositoryMmap<BlockIndex<VbkBlock>>;
+
+static std::vector<uint8_t> readFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in),
+          std::istreambuf_iterator<char>()};
+}
+
+static void writeFile(const std::string& path,
+                      const std::vector<uint8_t>& bytes,
+                      bool append = false) {
+  std::ofstream out(path,
+                    std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+  out.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+}
+
+// BTC and VBK blocks stored in mmap files, the rest is in memory
+struct PopStorageMmapTest : public PopStorageInmem {
+  explicit PopStorageMmapTest(const std::string& path) {
+    _brepoBtc = std::make_shared<btc_repo_t>(path + "_btc");
+    _brepoVbk = std::make_shared<vbk_repo_t>(path + "_vbk");
+  }
+};
+
+struct BlockRepositoryMmapTest : public PopTestFixture, public testing::Test {
+  std::string path = std::string("block_repository_mmap_test_") +
+                     testing::UnitTest::GetInstance()->current_test_info()->name();
+
+  BlockRepositoryMmapTest() {
+    removeFiles();
+    createEndorsedAltChain(10, 2);
+  }
+
+  ~BlockRepositoryMmapTest() override {
+    removeFiles();
+  }
+
+  void removeFiles() {
+    for (auto suffix : {"", "_btc", "_vbk"}) {
+      for (auto ext : {".dat", ".idx", ".dat.tmp", ".idx.tmp"}) {
+        std::remove((path + suffix + ext).c_str());
+      }
+    }
+  }
+
+  template <typename Repo, typename Tree>
+  void expectContainsTree(const Repo& repo, const Tree& tree) {
+    for (const auto& pair : tree.getBlocks()) {
+      typename Tree::index_t stored;
+      ASSERT_TRUE(repo.getByHash(pair.first, &stored));
+      EXPECT_EQ(stored.toRaw(), pair.second->toRaw());
+    }
+  }
+
+  template <typename Repo, typename Tree>
+  void putTree(Repo& repo, const Tree& tree) {
+    auto batch = repo.newBatch();
+    for (const auto& pair : tree.getBlocks()) {
+      batch->put(*pair.second);
+    }
+    batch->commit();
+  }
+};
+
+TEST_F(BlockRepositoryMmapTest, PutGetReopen) {
+  {
+    vbk_repo_t repo(path);
+    putTree(repo, alttree.vbk());
+    expectContainsTree(repo, alttree.vbk());
+  }
+
+  vbk_repo_t repo(path);
+  expectContainsTree(repo, alttree.vbk());
+
+  // cursor iterates all blocks in height order
+  auto cursor = repo.newCursor();
+  size_t count = 0;
+  int32_t height = -1;
+  for (cursor->seekToFirst(); cursor->isValid(); cursor->next()) {
+    auto block = cursor->value();
+    EXPECT_EQ(block.getHash(), cursor->key());
+    EXPECT_GE(block.getHeight(), height);
+    height = block.getHeight();
+    ++count;
+  }
+  EXPECT_EQ(count, alttree.vbk().getBlocks().size());
+}
+
+TEST_F(BlockRepositoryMmapTest, RebuildsIndexWithoutSidecar) {
+  {
+    btc_repo_t repo(path);
+    putTree(repo, alttree.btc());
+  }
+  std::remove((path + ".idx").c_str());
+
+  btc_repo_t repo(path);
+  expectContainsTree(repo, alttree.btc());
+}
+
+TEST_F(BlockRepositoryMmapTest, ReplaysRecordsAfterSidecar) {
+  auto* tip = alttree.btc().getBestChain().tip();
+  auto* removed = tip->pprev;
+  std::vector<uint8_t> sidecar;
+  {
+    btc_repo_t repo(path);
+    putTree(repo, alttree.btc());
+    repo.flush();
+    sidecar = readFile(path + ".idx");
+
+    // these records are not covered by the saved sidecar
+    auto changed = *tip;
+    changed.addRef(100);
+    EXPECT_TRUE(repo.put(changed));
+    EXPECT_TRUE(repo.removeByHash(removed->getHash()));
+    EXPECT_FALSE(repo.removeByHash(removed->getHash()));
+  }
+  // simulate crash before the sidecar has been updated
+  writeFile(path + ".idx", sidecar);
+
+  btc_repo_t repo(path);
+  BlockIndex<BtcBlock> stored;
+  ASSERT_TRUE(repo.getByHash(tip->getHash(), &stored));
+  EXPECT_EQ(stored.getRefs().back(), 100);
+  EXPECT_FALSE(repo.contains(removed->getHash()));
+  EXPECT_TRUE(repo.contains(tip->pprev->pprev->getHash()));
+}
+
+TEST_F(BlockRepositoryMmapTest, TruncatesTornTail) {
+  {
+    btc_repo_t repo(path);
+    putTree(repo, alttree.btc());
+  }
+  const auto size = readFile(path + ".dat").size();
+  // half-written record
+  writeFile(path + ".dat", {1, 0, 0, 0}, /*append=*/true);
+  std::remove((path + ".idx").c_str());
+
+  {
+    btc_repo_t repo(path);
+    EXPECT_EQ(repo.fileSize(), size);
+    expectContainsTree(repo, alttree.btc());
+    repo.put(*alttree.btc().getBestChain().tip());
+  }
+
+  btc_repo_t repo(path);
+  expectContainsTree(repo, alttree.btc());
+}
+
+TEST_F(BlockRepositoryMmapTest, CompactDropsSupersededRecords) {
+  btc_repo_t repo(path);
+  putTree(repo, alttree.btc());
+  const auto size = repo.fileSize();
+  putTree(repo, alttree.btc());
+  EXPECT_EQ(repo.fileSize(), 2 * size);
+
+  repo.compact();
+  EXPECT_EQ(repo.fileSize(), size);
+  expectContainsTree(repo, alttree.btc());
+
+  repo.clear();
+  EXPECT_EQ(repo.fileSize(), 0);
+  EXPECT_FALSE(repo.contains(alttree.btc().getBestChain().tip()->getHash()));
+}
+
+TEST_F(BlockRepositoryMmapTest, SaveLoadTrees) {
+  StorageManagerInmem storageManager2{};
+  PayloadsStorage& storagePayloads2 = storageManager2.getPayloadsStorage();
+  AltTree alttree2(altparam, vbkparam, btcparam, storagePayloads2);
+  ASSERT_TRUE(alttree2.btc().bootstrapWithGenesis(state));
+  ASSERT_TRUE(alttree2.vbk().bootstrapWithGenesis(state));
+  ASSERT_TRUE(alttree2.bootstrap(state));
+
+  auto cursor = storagePayloads.getRepo().newCursor();
+  auto batch = storagePayloads2.getRepo().newBatch();
+  for (cursor->seekToFirst(); cursor->isValid(); cursor->next()) {
+    batch->put(cursor->key(), cursor->value());
+  }
+  batch->commit();
+
+  PopStorageMmapTest storage(path);
+  auto adaptor = PopStorageBatchAdaptor(storage);
+  SaveAllTrees(alttree, adaptor);
+
+  ASSERT_TRUE(LoadTreeWrapper(alttree2.btc(), storage, state));
+  ASSERT_TRUE(LoadTreeWrapper(alttree2.vbk(), storage, state));
+  ASSERT_TRUE(LoadTreeWrapper(alttree2, storage, state));
+  ASSERT_TRUE(cmp(alttree, alttree2));
+}
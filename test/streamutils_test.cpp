@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include <vector>
+#include <veriblock/blob.hpp>
 #include <veriblock/read_stream.hpp>
 #include <veriblock/write_stream.hpp>
 
@@ -47,6 +48,23 @@ TEST(ReadStream, Read) {
   EXPECT_EQ(sl2[1], 3);
 }
 
+TEST(ReadStream, ReadInPlace) {
+  std::vector<uint8_t> buf{0, 1, 2, 3, 4};
+  altintegration::ReadStream stream(buf);
+
+  altintegration::Blob<2> blob;
+  stream.read(blob);
+  EXPECT_EQ(blob, altintegration::Blob<2>(std::vector<uint8_t>{0, 1}));
+
+  uint8_t out[2];
+  stream.read(2, out);
+  EXPECT_EQ(out[0], 2);
+  EXPECT_EQ(out[1], 3);
+
+  EXPECT_THROW(stream.read(blob), std::out_of_range);
+  EXPECT_EQ(stream.remaining(), 1u);
+}
+
 TEST(ReadStream, BE) {
   std::vector<uint8_t> buf{0x06, 0xfb, 0x0a, 0xfd};
   altintegration::ReadStream stream(buf);
@@ -143,3 +161,23 @@ TEST(WriteStream, BE) {
                 0xff, 0xff, 0xff, 0xfd, 0,    0,    0,    0,    0,    0,
                 0,    4,    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfc}));
 }
+
+TEST(WriteStream, ExternalBuffer) {
+  uint8_t buf[8]{};
+  altintegration::WriteStream stream(buf, sizeof(buf));
+  stream.writeBE<uint16_t>(0x0102);
+  stream.write(std::vector<uint8_t>{3, 4});
+  stream.writeLE<uint32_t>(0x08070605);
+
+  EXPECT_EQ(stream.size(), 8u);
+  EXPECT_EQ(stream.slice().data(), buf);
+  EXPECT_EQ(std::vector<uint8_t>(buf, buf + 8),
+            (std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8}));
+  EXPECT_THROW(stream.writeBE<uint8_t>(9), std::out_of_range);
+  EXPECT_THROW(stream.data(), std::logic_error);
+
+  stream.reset();
+  EXPECT_EQ(stream.size(), 0u);
+  stream.writeBE<uint8_t>(9);
+  EXPECT_EQ(buf[0], 9);
+}
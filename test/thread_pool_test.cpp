@@ -0,0 +1,60 @@
+// Copyright (c) 2019-2020 Xenios SEZC
+// https://www.veriblock.org
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "veriblock/thread_pool.hpp"
+
+using namespace altintegration;
+
+struct ThreadPoolTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(ThreadPoolTest, parallelFor_visits_every_index_once) {
+  ThreadPool pool(GetParam());
+  std::vector<std::atomic<int>> visited(1000);
+  pool.parallelFor(visited.size(), [&](size_t i) { visited[i]++; });
+  for (auto& v : visited) {
+    ASSERT_EQ(v.load(), 1);
+  }
+
+  // empty range is a no-op
+  pool.parallelFor(0, [](size_t) { FAIL(); });
+}
+
+TEST_P(ThreadPoolTest, parallelFor_rethrows) {
+  ThreadPool pool(GetParam());
+  std::atomic<int> executed{0};
+  ASSERT_THROW(pool.parallelFor(100,
+                                [&](size_t i) {
+                                  executed++;
+                                  if (i == 42) {
+                                    throw std::runtime_error("42");
+                                  }
+                                }),
+               std::runtime_error);
+  // all items are executed even if one of them failed
+  ASSERT_EQ(executed.load(), 100);
+}
+
+TEST_P(ThreadPoolTest, async) {
+  ThreadPool pool(GetParam());
+  std::atomic<int> value{0};
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 10; ++i) {
+    futures.push_back(pool.async([&value]() { value++; }));
+  }
+  for (auto& f : futures) {
+    f.get();
+  }
+  ASSERT_EQ(value.load(), 10);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadPoolRegression,
+                         ThreadPoolTest,
+                         testing::Values(0, 1, 4));